@@ -0,0 +1,47 @@
+# Generates a C++ source embedding compiled SPIR-V as constexpr word arrays, plus a registry of them.
+# Run in script mode:
+#   cmake -DOUTPUT=<cpp file> -DSPIRV_DIR=<root of spv files> -DSPIRV_FILES=<spv files separated by '|'> -P embed_shaders.cmake
+# Shaders are registered by their path relative to SPIRV_DIR without extension, e.g. "triangle/vertex".
+
+string(REPLACE "|" ";" SPIRV_FILES "${SPIRV_FILES}")
+
+set(ARRAYS "")
+set(ENTRIES "")
+
+foreach(SPIRV ${SPIRV_FILES})
+    file(RELATIVE_PATH SPIRV_NAME ${SPIRV_DIR} ${SPIRV})
+    string(REGEX REPLACE "\\.spv$" "" SPIRV_NAME ${SPIRV_NAME})
+    string(MAKE_C_IDENTIFIER ${SPIRV_NAME} SPIRV_IDENTIFIER)
+
+    file(READ ${SPIRV} SPIRV_HEX HEX)
+    string(LENGTH "${SPIRV_HEX}" SPIRV_HEX_LENGTH)
+    math(EXPR SPIRV_REMAINDER "${SPIRV_HEX_LENGTH} % 8")
+
+    if(SPIRV_HEX_LENGTH EQUAL 0 OR NOT SPIRV_REMAINDER EQUAL 0)
+        message(FATAL_ERROR "'${SPIRV}' does not contain valid SPIR-V.")
+    endif()
+
+    # SPIR-V words are little endian, so reverse the bytes of each group of four
+    string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1, " SPIRV_WORDS "${SPIRV_HEX}")
+    set(SPIRV_WORD "0x[0-9a-f]+, ")
+    string(REGEX REPLACE "(${SPIRV_WORD}${SPIRV_WORD}${SPIRV_WORD}${SPIRV_WORD}${SPIRV_WORD}${SPIRV_WORD}${SPIRV_WORD}${SPIRV_WORD})" "\\1\n        " SPIRV_WORDS "${SPIRV_WORDS}")
+    string(REGEX REPLACE ",[ \n]+$" "" SPIRV_WORDS "${SPIRV_WORDS}")
+    string(REGEX REPLACE " \n" "\n" SPIRV_WORDS "${SPIRV_WORDS}")
+
+    string(APPEND ARRAYS "    constexpr uint32_t ${SPIRV_IDENTIFIER}[] = {\n        ${SPIRV_WORDS}};\n\n")
+    string(APPEND ENTRIES "            {\"${SPIRV_NAME}\", ${SPIRV_IDENTIFIER}, std::size(${SPIRV_IDENTIFIER})},\n")
+endforeach()
+
+set(SOURCE "// Generated by cmake/embed_shaders.cmake, do not edit.\n\n")
+string(APPEND SOURCE "#include \"utils/vulkan/embedded_shader.hpp\"\n\n")
+string(APPEND SOURCE "#include <cstdint>\n#include <iterator>\n\n\n")
+string(APPEND SOURCE "namespace {\n\n${ARRAYS}}\n\n\n")
+string(APPEND SOURCE "namespace utils::vulkan {\n\n")
+string(APPEND SOURCE "    std::vector<EmbeddedShader> const& getEmbeddedShaders() {\n")
+string(APPEND SOURCE "        static std::vector<EmbeddedShader> const shaders {\n${ENTRIES}        };\n\n")
+string(APPEND SOURCE "        return shaders;\n    }\n\n}\n")
+
+# Only touch the output when it changes, so unchanged shaders don't trigger a recompile
+file(WRITE ${OUTPUT}.tmp "${SOURCE}")
+file(COPY_FILE ${OUTPUT}.tmp ${OUTPUT} ONLY_IF_DIFFERENT)
+file(REMOVE ${OUTPUT}.tmp)
@@ -2,8 +2,10 @@
 #include "utils/glfw/window.hpp"
 #include "utils/vulkan/instance.hpp"
 #include "utils/vulkan/device.hpp"
+#include "utils/vulkan/embedded_shader.hpp"
 #include "utils/vulkan/swap_chain.hpp"
 #include "utils/vulkan/render_pass.hpp"
+#include "utils/vulkan/frame_graph.hpp"
 #include "utils/misc/logging.hpp"
 #include "utils/misc/file.hpp"
 #include "utils/misc/image.hpp"
@@ -24,17 +26,14 @@
 #include <map>
 
 
+// Vertex input state is reflected from the vertex shader, which assumes tightly packed inputs in location order
 struct ColorVertex {
     glm::vec2 position;
     glm::vec3 color;
-
-    static void addToConfig(utils::vulkan::VertexInfo * const vertexInfo) {
-        uint32_t index = vertexInfo->addVertexType(sizeof(ColorVertex), VK_VERTEX_INPUT_RATE_VERTEX);
-        vertexInfo->addVertexAttribute(index, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ColorVertex, position));
-        vertexInfo->addVertexAttribute(index, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(ColorVertex, color));
-    }
 };
 
+static_assert(sizeof(ColorVertex) == sizeof(glm::vec2) + sizeof(glm::vec3), "ColorVertex must be tightly packed.");
+
 
 std::vector<ColorVertex> const squareVertices = {
     {{-0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}},
@@ -48,12 +47,16 @@ std::vector<uint16_t> squareIndices = {0, 1, 2, 2, 3, 0};
 
 
 struct UniformBufferObject {
-    glm::mat4 model;
     glm::mat4 view;
     glm::mat4 projection;
 };
 
 
+struct ObjectPushConstants {
+    glm::mat4 model;
+};
+
+
 class Application {
 private:
     static utils::Logger log;
@@ -67,6 +70,7 @@ private:
     std::shared_ptr<utils::vulkan::Queue> vkGraphicsQueue;
 
     std::shared_ptr<utils::vulkan::SwapChain> vkSwapChain;
+    std::vector<std::shared_ptr<utils::vulkan::Image>> vkSwapChainImages;
     std::vector<std::shared_ptr<utils::vulkan::ImageView>> vkSwapChainImageViews;
     std::vector<std::shared_ptr<utils::vulkan::FrameBuffer>> vkFrameBuffers;
 
@@ -77,10 +81,10 @@ private:
     std::shared_ptr<utils::vulkan::RenderPass> vkRenderPass;
     std::shared_ptr<utils::vulkan::GraphicsPipeline> vkGraphicsPipeline;
     std::shared_ptr<utils::vulkan::CommandPool> vkCommandPool;
-    std::shared_ptr<utils::vulkan::DescriptorPool> vkDescriptorPool;
+    std::shared_ptr<utils::vulkan::DescriptorSetCache> vkDescriptorSetCache;
 
-    std::shared_ptr<utils::vulkan::Buffer> vkVertexBuffer;
-    std::shared_ptr<utils::vulkan::Buffer> vkIndexBuffer;
+    std::shared_ptr<utils::vulkan::Buffer> vkGeometryBuffer;
+    uint64_t indexBufferOffset = 0;
     std::shared_ptr<utils::vulkan::Image> vkTextureImage;
 
     std::vector<std::string> const debugValidationLayers = {
@@ -88,11 +92,29 @@ private:
     };
 
     std::vector<std::string> const requiredDeviceExtensions = {
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME
+        VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+        VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
+        // Descriptor allocation reports an exhausted pool instead of it being invalid usage
+        VK_KHR_MAINTENANCE1_EXTENSION_NAME
+    };
+
+    // Enabled when available, features depending on them fall back to plain pipeline creation
+    std::vector<std::string> const optionalDeviceExtensions = {
+        VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME,
+        VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME,
+        VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME,
+        VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
+        VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME,
+        VK_KHR_MAINTENANCE3_EXTENSION_NAME,
+        VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
+        VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME,
+        VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME
     };
 
     std::string const graphicsQueueName = "GRAPHICS_QUEUE";
 
+    std::filesystem::path const pipelineCachePath = "pipeline_cache.bin";
+
     uint32_t const MAX_FRAMES_IN_FLIGHT = 2;
 
 
@@ -204,38 +226,29 @@ private:
         output.format = this->vkSwapChain->config.surfaceFormat.format;
         output.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
         output.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        output.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+        // Layout transitions and synchronization with presentation are handled by the frame graph
+        output.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        output.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
         uint32_t outputIndex = config.addAttachment(output);
 
         utils::vulkan::SubPassDescription subPass(VK_PIPELINE_BIND_POINT_GRAPHICS);
         subPass.addColorAttachment(outputIndex, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        config.addSubPass(subPass);
 
-        uint32_t subPassIndex = config.addSubPass(subPass);
-        config.addSubPassDependency(
-            VK_SUBPASS_EXTERNAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, subPassIndex,
-            subPassIndex, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
-        );
-
-        return config;
-    }
-
-
-    utils::vulkan::DescriptorSetLayoutConfig createDescriptorSetLayoutConfig() {
-        utils::vulkan::DescriptorSetLayoutConfig config;
-        config.addDescriptor(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT);
         return config;
     }
 
 
-    utils::vulkan::PipelineLayoutConfig createPipelineLayoutConfig() {
-        if (this->vkDescriptorSetLayout == nullptr) {
-            throw std::runtime_error("Cannot create pipeline layout config, descriptor set layout is not initialized.");
-        }
+    utils::vulkan::ShaderReflection createShaderReflection() {
+        utils::vulkan::ShaderReflection reflection;
+        reflection.merge(this->vkVertexShaderModule->getReflection());
+        reflection.merge(this->vkFragmentShaderModule->getReflection());
 
-        utils::vulkan::PipelineLayoutConfig config;
-        config.addDescriptorSet(this->vkDescriptorSetLayout);
-        return config;
+        // Each frame in flight uses its own slice of the uniform buffer, selected with a dynamic offset
+        reflection.setDescriptorType(0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+        return reflection;
     }
 
 
@@ -245,7 +258,7 @@ private:
         config.addShaderStage(this->vkVertexShaderModule->getHandle(), VK_SHADER_STAGE_VERTEX_BIT);
         config.addShaderStage(this->vkFragmentShaderModule->getHandle(), VK_SHADER_STAGE_FRAGMENT_BIT);
 
-        ColorVertex::addToConfig(&config.vertexInfo);
+        config.vertexInfo = this->vkVertexShaderModule->getReflection().getVertexInfo();
 
         return config;
     }
@@ -258,9 +271,9 @@ private:
     }
 
 
-    utils::vulkan::DescriptorPoolConfig createDescriptorPoolConfig() {
-        utils::vulkan::DescriptorPoolConfig config(MAX_FRAMES_IN_FLIGHT);
-        config.addPool(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_FRAMES_IN_FLIGHT);
+    utils::vulkan::DescriptorAllocatorConfig createDescriptorSetCacheConfig() {
+        utils::vulkan::DescriptorAllocatorConfig config;
+        config.addDescriptorType(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1);
         return config;
     }
 
@@ -278,9 +291,11 @@ private:
 
         this->vkFrameBuffers.clear();
         this->vkSwapChainImageViews.clear();
+        this->vkSwapChainImages.clear();
         this->vkSwapChain.reset();
 
         this->vkSwapChain = this->vkDevice->createSwapChain(this->vkPresentSurface, buildSwapChainConfig());
+        this->vkSwapChainImages = this->vkSwapChain->getImages();
         this->vkSwapChainImageViews = this->vkSwapChain->createImageViews(createSwapChainImageViewConfig());
 
         for (unsigned i = 0; i < this->vkSwapChainImageViews.size(); i++) {
@@ -293,68 +308,22 @@ private:
     }
 
 
-    void initializeVertexBuffer() {
-        // Set up staging buffer
-        auto stagingBuffer = this->vkDevice->createBuffer(
-            squareVertices.size() * sizeof(ColorVertex),
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_SHARING_MODE_EXCLUSIVE);
-
-        auto const stagingBufferRequirements = stagingBuffer->getMemoryRequirements();
-
-        uint32_t const stagingBufferMemoryType = this->vkPhysicalDevice->selectMemoryType(
-            stagingBufferRequirements.memoryTypeBits,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        std::shared_ptr<utils::vulkan::DeviceMemory> stagingBufferMemory = this->vkDevice->allocateDeviceMemory(
-            stagingBufferMemoryType, stagingBufferRequirements.size);
-
-        stagingBuffer->bindMemory(stagingBufferMemory, 0);
-
-        // Copy data to staging buffer
-        stagingBuffer->mapMemory();
-        memcpy(stagingBuffer->getMappedMemory(), squareVertices.data(), stagingBuffer->getMemorySize());
-        stagingBuffer->unmapMemory();
-
-        // Set up device buffer
-        this->vkVertexBuffer = this->vkDevice->createBuffer(
-            squareVertices.size() * sizeof(ColorVertex),
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-            VK_SHARING_MODE_EXCLUSIVE);
-
-        auto const deviceBufferMemoryRequirements = this->vkVertexBuffer->getMemoryRequirements();
-
-        uint32_t const deviceBufferMemoryType = this->vkPhysicalDevice->selectMemoryType(
-            deviceBufferMemoryRequirements.memoryTypeBits,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-        std::shared_ptr<utils::vulkan::DeviceMemory> deviceBufferMemory = this->vkDevice->allocateDeviceMemory(
-            deviceBufferMemoryType, deviceBufferMemoryRequirements.size);
-
-        this->vkVertexBuffer->bindMemory(deviceBufferMemory, 0);
-
-        // Copy the staging buffer contents to the GPU
-        std::shared_ptr<utils::vulkan::CommandBuffer> initCommandBuffer =
-            this->vkCommandPool->allocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-
-        initCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-        initCommandBuffer->copyBuffer(stagingBuffer, this->vkVertexBuffer);
-        initCommandBuffer->end();
-
-        std::shared_ptr<utils::vulkan::Fence> uploadCompleteFence = this->vkDevice->createFence();
-
-        this->vkGraphicsQueue->submit(
-            {}, {}, {}, {initCommandBuffer},
-            uploadCompleteFence);
-
-        uploadCompleteFence->wait();
-    }
+    /**
+     * @brief Upload vertex and index data into a single shared geometry buffer.
+     * Vertices go at the start of the buffer and indices follow, so one allocation
+     * serves both binds.
+     */
+    void initializeGeometryBuffer() {
+        uint64_t const vertexDataSize = squareVertices.size() * sizeof(ColorVertex);
+        uint64_t const indexDataSize = squareIndices.size() * sizeof(squareIndices[0]);
 
+        // Index buffer offsets must be a multiple of the index size
+        this->indexBufferOffset = (vertexDataSize + sizeof(squareIndices[0]) - 1) / sizeof(squareIndices[0]) * sizeof(squareIndices[0]);
+        uint64_t const geometrySize = this->indexBufferOffset + indexDataSize;
 
-    void initializeIndexBuffer() {
         // Set up staging buffer
         auto stagingBuffer = this->vkDevice->createBuffer(
-            squareIndices.size() * sizeof(squareIndices[0]),
+            geometrySize,
             VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
             VK_SHARING_MODE_EXCLUSIVE);
 
@@ -371,16 +340,18 @@ private:
 
         // Copy data to staging buffer
         stagingBuffer->mapMemory();
-        memcpy(stagingBuffer->getMappedMemory(), squareIndices.data(), stagingBuffer->getMemorySize());
+        auto * const stagingData = static_cast<uint8_t *>(stagingBuffer->getMappedMemory());
+        memcpy(stagingData, squareVertices.data(), vertexDataSize);
+        memcpy(stagingData + this->indexBufferOffset, squareIndices.data(), indexDataSize);
         stagingBuffer->unmapMemory();
 
         // Set up device buffer
-        this->vkIndexBuffer = this->vkDevice->createBuffer(
-            squareIndices.size() * sizeof(squareIndices[0]),
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        this->vkGeometryBuffer = this->vkDevice->createBuffer(
+            geometrySize,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
             VK_SHARING_MODE_EXCLUSIVE);
 
-        auto const deviceBufferMemoryRequirements = this->vkIndexBuffer->getMemoryRequirements();
+        auto const deviceBufferMemoryRequirements = this->vkGeometryBuffer->getMemoryRequirements();
 
         uint32_t const deviceBufferMemoryType = this->vkPhysicalDevice->selectMemoryType(
             deviceBufferMemoryRequirements.memoryTypeBits,
@@ -389,23 +360,20 @@ private:
         std::shared_ptr<utils::vulkan::DeviceMemory> deviceBufferMemory = this->vkDevice->allocateDeviceMemory(
             deviceBufferMemoryType, deviceBufferMemoryRequirements.size);
 
-        this->vkIndexBuffer->bindMemory(deviceBufferMemory, 0);
+        this->vkGeometryBuffer->bindMemory(deviceBufferMemory, 0);
 
         // Copy the staging buffer contents to the GPU
         std::shared_ptr<utils::vulkan::CommandBuffer> initCommandBuffer =
             this->vkCommandPool->allocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
         initCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-        initCommandBuffer->copyBuffer(stagingBuffer, this->vkIndexBuffer);
+        initCommandBuffer->copyBuffer(stagingBuffer, this->vkGeometryBuffer, 0, 0, geometrySize);
         initCommandBuffer->end();
 
-        std::shared_ptr<utils::vulkan::Fence> uploadCompleteFence = this->vkDevice->createFence();
-
-        this->vkGraphicsQueue->submit(
-            {}, {}, {}, {initCommandBuffer},
-            uploadCompleteFence);
+        utils::vulkan::SubmitBatch uploadBatch;
+        uploadBatch.addCommandBuffer(initCommandBuffer);
 
-        uploadCompleteFence->wait();
+        this->vkGraphicsQueue->waitFor(this->vkGraphicsQueue->submit(uploadBatch));
     }
 
 
@@ -456,20 +424,17 @@ private:
         std::shared_ptr<utils::vulkan::CommandBuffer> initCommandBuffer =
             this->vkCommandPool->allocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
-        utils::vulkan::MutableImageSettings settings = this->vkTextureImage->getMutableSettings();
-        settings.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-
         initCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-        initCommandBuffer->pipelineBarrier(this->vkTextureImage->updateSettings(settings));
+        initCommandBuffer->useImage(
+            this->vkTextureImage,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT});
         initCommandBuffer->end();
 
-        std::shared_ptr<utils::vulkan::Fence> uploadCompleteFence = this->vkDevice->createFence();
-
-        this->vkGraphicsQueue->submit(
-            {}, {}, {}, {initCommandBuffer},
-            uploadCompleteFence);
+        utils::vulkan::SubmitBatch uploadBatch;
+        uploadBatch.addCommandBuffer(initCommandBuffer);
 
-        uploadCompleteFence->wait();
+        this->vkGraphicsQueue->waitFor(this->vkGraphicsQueue->submit(uploadBatch));
     }
 
 
@@ -487,23 +452,36 @@ public:
 
         INFO(log) << "Selected physical device '" << this->vkPhysicalDevice->getProperties().deviceName << '\'' << std::endl;
 
-        this->vkDevice = this->vkPhysicalDevice->createLogicalDevice(queuePlan, requiredDeviceExtensions);
+        this->vkDevice = this->vkPhysicalDevice->createLogicalDevice(queuePlan, requiredDeviceExtensions, optionalDeviceExtensions);
+        this->vkDevice->loadPipelineCache(pipelineCachePath);
 
         this->vkGraphicsQueue = this->vkDevice->getQueue(graphicsQueueName);
         this->vkSwapChain = this->vkDevice->createSwapChain(this->vkPresentSurface, buildSwapChainConfig());
+        this->vkSwapChainImages = this->vkSwapChain->getImages();
         this->vkSwapChainImageViews = this->vkSwapChain->createImageViews(createSwapChainImageViewConfig());
 
-        this->vkVertexShaderModule = this->vkDevice->createShaderModule("data/shaders/triangle/vertex.spv");
-        this->vkFragmentShaderModule = this->vkDevice->createShaderModule("data/shaders/triangle/fragment.spv");
-        this->vkDescriptorSetLayout = this->vkDevice->createDescriptorSetLayout(createDescriptorSetLayoutConfig());
-        this->vkPipelineLayout = this->vkDevice->createPipelineLayout(createPipelineLayoutConfig());
+        this->vkVertexShaderModule = this->vkDevice->createShaderModule(utils::vulkan::getEmbeddedShader("triangle/vertex"));
+        this->vkFragmentShaderModule = this->vkDevice->createShaderModule(utils::vulkan::getEmbeddedShader("triangle/fragment"));
+
+        auto const shaderReflection = createShaderReflection();
+        this->vkDescriptorSetLayout = this->vkDevice->createDescriptorSetLayout(shaderReflection.getDescriptorSetLayoutConfig(0));
+        this->vkPipelineLayout = this->vkDevice->createPipelineLayout(shaderReflection);
+
         this->vkRenderPass = this->vkDevice->createRenderPass(createRenderPassConfig());
 
+        auto const pipelineStartTime = std::chrono::high_resolution_clock::now();
+
         this->vkGraphicsPipeline = this->vkDevice->createGraphicsPipeline(
             this->vkPipelineLayout,
             this->vkRenderPass,
             createGraphicsPipelineConfig());
 
+        auto const pipelineEndTime = std::chrono::high_resolution_clock::now();
+        float const pipelineTime = std::chrono::duration<float, std::chrono::milliseconds::period>(pipelineEndTime - pipelineStartTime).count();
+
+        INFO(log) << "Graphics pipeline created in " << pipelineTime << "ms ("
+                  << (this->vkDevice->getPipelineCache()->isWarm() ? "warm" : "cold") << " pipeline cache)" << std::endl;
+
         for (unsigned i = 0; i < this->vkSwapChainImageViews.size(); i++) {
             utils::vulkan::FrameBufferConfig config(this->vkSwapChain->config.imageExtent);
             config.addAttachment(this->vkSwapChainImageViews[i]->getHandle());
@@ -511,95 +489,150 @@ public:
         }
 
         this->vkCommandPool = this->vkDevice->createCommandPool(createCommandPoolConfig());
-        this->vkDescriptorPool = this->vkDevice->createDescriptorPool(createDescriptorPoolConfig());
+        this->vkDescriptorSetCache = this->vkDevice->createDescriptorSetCache(createDescriptorSetCacheConfig());
 
         loadImage("data/textures/test/statue.jpg");
     }
 
 
-    void updateUniformBuffer(std::shared_ptr<utils::vulkan::Buffer> const& uniformBuffer) {
+    ObjectPushConstants getObjectPushConstants() const {
         static auto const startTime = std::chrono::high_resolution_clock::now();
 
         auto currentTime = std::chrono::high_resolution_clock::now();
         float time = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
 
+        ObjectPushConstants pushConstants {};
+        pushConstants.model = glm::rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        return pushConstants;
+    }
+
+
+    /**
+     * @brief Size of each frame's slice of the shared uniform buffer.
+     * Dynamic offsets must be a multiple of minUniformBufferOffsetAlignment.
+     */
+    uint64_t getUniformBufferStride() const {
+        uint64_t const alignment = this->vkPhysicalDevice->getProperties().limits.minUniformBufferOffsetAlignment;
+        return (sizeof(UniformBufferObject) + alignment - 1) / alignment * alignment;
+    }
+
+
+    void updateUniformBuffer(std::shared_ptr<utils::vulkan::Buffer> const& uniformBuffer, uint64_t const offset) {
         uint32_t const windowWidth = this->vkSwapChain->config.imageExtent.width;
         uint32_t const windowHeight = this->vkSwapChain->config.imageExtent.height;
 
         UniformBufferObject ubo {};
-        ubo.model = glm::rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
         ubo.view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
         ubo.projection = glm::perspective(glm::radians(45.0f), (float) windowWidth / (float) windowHeight, 0.1f, 10.0f);
         ubo.projection[1][1] *= -1;
 
-        memcpy(uniformBuffer->getMappedMemory(), &ubo, sizeof(UniformBufferObject));
+        memcpy(static_cast<uint8_t *>(uniformBuffer->getMappedMemory()) + offset, &ubo, sizeof(UniformBufferObject));
     }
 
 
     void run() {
-        initializeVertexBuffer();
-        initializeIndexBuffer();
+        initializeGeometryBuffer();
 
         unsigned contextIndex = 0;
 
-        std::vector<std::shared_ptr<utils::vulkan::Buffer>> uniformBuffers(MAX_FRAMES_IN_FLIGHT);
-        std::vector<std::shared_ptr<utils::vulkan::DeviceMemory>> uniformBufferMemory(MAX_FRAMES_IN_FLIGHT);
-        std::vector<std::shared_ptr<utils::vulkan::DescriptorSet>> descriptorSets(MAX_FRAMES_IN_FLIGHT);
+        // One uniform buffer and descriptor set shared by all frames, each frame uses its own slice
+        uint64_t const uniformBufferStride = getUniformBufferStride();
 
-        std::vector<std::shared_ptr<utils::vulkan::CommandBuffer>> commandBuffers(MAX_FRAMES_IN_FLIGHT);
-        std::vector<std::shared_ptr<utils::vulkan::Semaphore>> imageAvailableSemaphores(MAX_FRAMES_IN_FLIGHT);
-        std::vector<std::shared_ptr<utils::vulkan::Semaphore>> renderCompleteSemaphores(MAX_FRAMES_IN_FLIGHT);
-        std::vector<std::shared_ptr<utils::vulkan::Fence>> inFlightFences(MAX_FRAMES_IN_FLIGHT);
+        auto const uniformBuffer = this->vkDevice->createBuffer(
+            uniformBufferStride * MAX_FRAMES_IN_FLIGHT,
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            VK_SHARING_MODE_EXCLUSIVE);
 
-        for (unsigned i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            uniformBuffers[i] = this->vkDevice->createBuffer(
-                sizeof(UniformBufferObject),
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                VK_SHARING_MODE_EXCLUSIVE);
+        auto const uniformBufferRequirements = uniformBuffer->getMemoryRequirements();
 
-            auto const uniformBufferRequirements = uniformBuffers[i]->getMemoryRequirements();
+        uint32_t const uniformBufferMemoryType = this->vkPhysicalDevice->selectMemoryType(
+            uniformBufferRequirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-            uint32_t const uniformBufferMemoryType = this->vkPhysicalDevice->selectMemoryType(
-                uniformBufferRequirements.memoryTypeBits,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        auto const uniformBufferMemory = this->vkDevice->allocateDeviceMemory(
+            uniformBufferMemoryType, uniformBufferRequirements.size);
 
-            uniformBufferMemory[i] = this->vkDevice->allocateDeviceMemory(
-                uniformBufferMemoryType, uniformBufferRequirements.size);
+        uniformBuffer->bindMemory(uniformBufferMemory, 0);
+        uniformBuffer->mapMemory();
 
-            uniformBuffers[i]->bindMemory(uniformBufferMemory[i], 0);
-            uniformBuffers[i]->mapMemory();
+        utils::vulkan::DescriptorSetBindings uniformBindings;
+        uniformBindings.addBuffer(0, uniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0, sizeof(UniformBufferObject));
+        auto const descriptorSet = this->vkDescriptorSetCache->get(this->vkDescriptorSetLayout, uniformBindings);
 
-            descriptorSets[i] = this->vkDescriptorPool->allocateDescriptorSet(this->vkDescriptorSetLayout);
-            descriptorSets[i]->update(0, uniformBuffers[i]);
+        std::vector<std::shared_ptr<utils::vulkan::CommandBuffer>> commandBuffers(MAX_FRAMES_IN_FLIGHT);
+        std::vector<std::shared_ptr<utils::vulkan::Semaphore>> imageAvailableSemaphores(MAX_FRAMES_IN_FLIGHT);
+        std::vector<std::shared_ptr<utils::vulkan::Semaphore>> renderCompleteSemaphores(MAX_FRAMES_IN_FLIGHT);
+        std::vector<uint64_t> frameSubmitValues(MAX_FRAMES_IN_FLIGHT, 0);
 
+        for (unsigned i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
             commandBuffers[i] = this->vkCommandPool->allocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
             imageAvailableSemaphores[i] = this->vkDevice->createSemaphore();
             renderCompleteSemaphores[i] = this->vkDevice->createSemaphore();
-            inFlightFences[i] = this->vkDevice->createFence(VK_FENCE_CREATE_SIGNALED_BIT);
         }
 
+        // Per-frame values used by the frame graph's record functions
+        uint32_t nextImageIndex = 0;
+        uint32_t uniformBufferOffset = 0;
+
+        utils::vulkan::FrameGraph frameGraph(this->vkDevice, this->vkPhysicalDevice);
+
+        // Swap chain image contents are cleared each frame, but must wait for the acquire semaphore
+        uint32_t const swapChainImage = frameGraph.importImage(
+            "swap chain image", true, {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0});
+
+        uint32_t const geometryBuffer = frameGraph.importBuffer("geometry buffer");
+        frameGraph.setImportedBuffer(geometryBuffer, this->vkGeometryBuffer);
+
+        frameGraph.addPass("draw square")
+            .writeColorAttachment(swapChainImage)
+            .readBuffer(geometryBuffer, {
+                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT})
+            .setRecordFunction([&](std::shared_ptr<utils::vulkan::CommandBuffer> const& commandBuffer) {
+                commandBuffer->beginRenderPass(
+                    this->vkRenderPass,
+                    this->vkFrameBuffers[nextImageIndex],
+                    {0, 0},
+                    this->vkSwapChain->config.imageExtent);
+                commandBuffer->bindGraphicsPipeline(this->vkGraphicsPipeline);
+                commandBuffer->setViewport(this->vkSwapChain->config.imageExtent);
+                commandBuffer->setScissor({0, 0}, this->vkSwapChain->config.imageExtent);
+                commandBuffer->bindVertexBuffer(this->vkGeometryBuffer, 0, 0);
+                commandBuffer->bindIndexBuffer(this->vkGeometryBuffer, VK_INDEX_TYPE_UINT16, this->indexBufferOffset);
+                commandBuffer->bindDescriptorSet(
+                    descriptorSet, this->vkPipelineLayout, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, {uniformBufferOffset});
+                commandBuffer->pushConstants(this->vkPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, getObjectPushConstants());
+                commandBuffer->drawIndexed(squareIndices.size(), 1, 0, 0, 0);
+                commandBuffer->endRenderPass();
+            });
+
+        frameGraph.markOutput(swapChainImage, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0});
+        frameGraph.compile();
+
+        // Reused every frame, so submission does not allocate once the batch has grown to size
+        utils::vulkan::SubmitBatch submitBatch;
+
         INFO(log) << "Main loop starting." << std::endl;
 
         while (!glfwWindow->shouldClose()) {
             glfwPollEvents();
 
-            auto const& uniformBuffer = uniformBuffers[contextIndex];
-            auto const& descriptorSet = descriptorSets[contextIndex];
+            uniformBufferOffset = static_cast<uint32_t>(uniformBufferStride * contextIndex);
             auto const& commandBuffer = commandBuffers[contextIndex];
             auto const& imageAvailableSemaphore = imageAvailableSemaphores[contextIndex];
             auto const& renderCompleteSemaphore = renderCompleteSemaphores[contextIndex];
-            auto const& inFlightFence = inFlightFences[contextIndex];
+            auto& frameSubmitValue = frameSubmitValues[contextIndex];
 
-            updateUniformBuffer(uniformBuffer);
+            updateUniformBuffer(uniformBuffer, uniformBufferOffset);
 
             contextIndex = (contextIndex + 1) % MAX_FRAMES_IN_FLIGHT;
 
             // Wait for the previous frame to be done
-            inFlightFence->wait();
+            this->vkGraphicsQueue->waitFor(frameSubmitValue);
 
             // Get an image from the swap chain
             VkResult result;
-            uint32_t const nextImageIndex = this->vkSwapChain->getNextImage(imageAvailableSemaphore, &result);
+            nextImageIndex = this->vkSwapChain->getNextImage(imageAvailableSemaphore, &result);
 
             if (result == VK_ERROR_OUT_OF_DATE_KHR) {
                 recreateSwapChain();
@@ -608,38 +641,25 @@ public:
                 throw std::runtime_error("Failed to acquire swap chain image.");
             }
 
-            // Reset the fence in preparation for doing work
-            inFlightFence->reset();
-
             // Record the command buffer
             commandBuffer->reset();
             commandBuffer->begin();
-            commandBuffer->beginRenderPass(
-                this->vkRenderPass,
-                this->vkFrameBuffers[nextImageIndex],
-                {0, 0},
-                this->vkSwapChain->config.imageExtent);
-            commandBuffer->bindGraphicsPipeline(this->vkGraphicsPipeline);
-            commandBuffer->setViewport(this->vkSwapChain->config.imageExtent);
-            commandBuffer->setScissor({0, 0}, this->vkSwapChain->config.imageExtent);
-            commandBuffer->bindVertexBuffer(this->vkVertexBuffer);
-            commandBuffer->bindIndexBuffer(this->vkIndexBuffer, VK_INDEX_TYPE_UINT16);
-            commandBuffer->bindDescriptorSet(descriptorSet, this->vkPipelineLayout, VK_PIPELINE_BIND_POINT_GRAPHICS);
-            commandBuffer->drawIndexed(squareIndices.size(), 1, 0, 0, 0);
-            commandBuffer->endRenderPass();
+            frameGraph.setImportedImage(swapChainImage, this->vkSwapChainImages[nextImageIndex]);
+            frameGraph.execute(commandBuffer);
             commandBuffer->end();
 
             // Submit the command buffer to render some stuff
-            this->vkGraphicsQueue->submit(
-                {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT},
-                {imageAvailableSemaphore},
-                {renderCompleteSemaphore},
-                {commandBuffer},
-                inFlightFence);
+            submitBatch.clear();
+            submitBatch
+                .addWait(imageAvailableSemaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT)
+                .addCommandBuffer(commandBuffer)
+                .addSignal(renderCompleteSemaphore);
+
+            frameSubmitValue = this->vkGraphicsQueue->submit(submitBatch);
 
             // Present the rendered image!
             this->vkGraphicsQueue->present(
-                {renderCompleteSemaphore},
+                renderCompleteSemaphore,
                 this->vkSwapChain,
                 nextImageIndex,
                 &result);
@@ -655,6 +675,7 @@ public:
         INFO(log) << "Main loop stopped, waiting for device idle..." << std::endl;
 
         this->vkDevice->waitIdle();
+        this->vkDevice->savePipelineCache(pipelineCachePath);
 
         INFO(log) << "Device idle, shutting down." << std::endl;
     }
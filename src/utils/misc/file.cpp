@@ -36,4 +36,21 @@ namespace utils {
         return buffer;
     }
 
+
+    void writeBinaryFile(std::filesystem::path const& path, std::vector<char> const& data) {
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+
+        std::ofstream ofs(temporaryPath, std::ios::binary | std::ios::trunc);
+        ofs.write(data.data(), data.size());
+        ofs.close();
+
+        if (!ofs) {
+            std::filesystem::remove(temporaryPath);
+            throw std::runtime_error("Failed to write '" + std::string(temporaryPath) + "'");
+        }
+
+        std::filesystem::rename(temporaryPath, path);
+    }
+
 }
@@ -28,4 +28,14 @@ namespace utils {
      */
     std::vector<char> readBinaryFile(std::filesystem::path const& path);
 
+    /**
+     * @brief Replace the contents of a file atomically.
+     * Data is written to a temporary file next to the target, which is then renamed over it,
+     * so readers never observe a partially written file.
+     * @param path Path to the file to write.
+     * @param data Vector of chars to write.
+     * @throw std::runtime_error if the file could not be written.
+     */
+    void writeBinaryFile(std::filesystem::path const& path, std::vector<char> const& data);
+
 }
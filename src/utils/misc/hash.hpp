@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+
+namespace utils {
+
+    /**
+     * @brief Mix the hash of a value into an existing hash.
+     * @param seed Hash to update.
+     * @param value Value to mix in, must be hashable with std::hash.
+     */
+    template<typename T>
+    void hashCombine(std::size_t& seed, T const& value) {
+        seed ^= std::hash<T>()(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+
+    /**
+     * @brief Hash a block of memory with 64 bit FNV-1a.
+     * Unlike std::hash the result is stable between runs, so it can identify file contents.
+     * @param data Pointer to the data to hash.
+     * @param size Size of the data in bytes.
+     */
+    inline uint64_t fnv1a(void const * const data, std::size_t const size) {
+        auto const bytes = static_cast<uint8_t const *>(data);
+        uint64_t hash = 0xcbf29ce484222325ull;
+
+        for (std::size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+}
@@ -0,0 +1,55 @@
+#include "utils/misc/thread_pool.hpp"
+
+#include <algorithm>
+
+
+namespace utils {
+
+    ThreadPool::ThreadPool(unsigned const threadCount) {
+        // hardware_concurrency() may return 0 if it can't be determined
+        unsigned const workerCount = std::max(threadCount, 1u);
+
+        for (unsigned i = 0; i < workerCount; i++) {
+            this->workers.emplace_back(&ThreadPool::run, this);
+        }
+    }
+
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+
+        this->condition.notify_all();
+
+        for (auto& worker : this->workers) {
+            worker.join();
+        }
+    }
+
+
+    void ThreadPool::run() {
+        while (true) {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+
+                this->condition.wait(lock, [this] {
+                    return this->stopping || !this->tasks.empty();
+                });
+
+                if (this->tasks.empty()) {
+                    return;
+                }
+
+                task = std::move(this->tasks.front());
+                this->tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+}
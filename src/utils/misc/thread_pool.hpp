@@ -0,0 +1,84 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace utils {
+
+    /**
+     * @brief Fixed size pool of worker threads which execute tasks in submission order.
+     */
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping = false;
+
+        /**
+         * @brief Worker thread main loop.
+         */
+        void run();
+
+    public:
+        /**
+         * @brief Start the worker threads.
+         * @param threadCount Number of worker threads, defaults to the number of hardware threads.
+         */
+        ThreadPool(unsigned const threadCount = std::thread::hardware_concurrency());
+
+        /**
+         * @brief Finish all queued tasks and stop the worker threads.
+         */
+        ~ThreadPool();
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        /**
+         * @brief Get the number of worker threads.
+         */
+        unsigned size() const {
+            return static_cast<unsigned>(this->workers.size());
+        }
+
+        /**
+         * @brief Queue a task for execution on a worker thread.
+         * @param function Callable taking no arguments.
+         * @return Future holding the task's result, or any exception it threw.
+         */
+        template<typename F>
+        std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& function) {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+
+            // std::function must be copyable, so the task is shared rather than moved in
+            auto const task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(function));
+            auto future = task->get_future();
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                if (this->stopping) {
+                    throw std::runtime_error("Unable to submit task, thread pool is stopping.");
+                }
+
+                this->tasks.emplace_back([task] { (*task)(); });
+            }
+
+            this->condition.notify_one();
+            return future;
+        }
+    };
+
+}
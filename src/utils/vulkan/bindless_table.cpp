@@ -0,0 +1,134 @@
+#include "utils/vulkan/bindless_table.hpp"
+
+
+namespace utils::vulkan {
+
+    utils::Logger BindlessTable::log("BindlessTable");
+
+
+    BindlessTable::BindlessTable(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        BindlessTableConfig const& config
+    ) :
+        vkDeviceHandle(vkDeviceHandle),
+        writer(vkDeviceHandle),
+        config(config)
+    {
+        INFO(log) << "Creating bindless table with space for " << config.bufferCapacity << " buffers and "
+                  << config.imageCapacity << " images." << std::endl;
+
+        // Slots may be empty, and unused ones may be written while frames using the set are in flight
+        VkDescriptorBindingFlagsEXT const bindingFlags =
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+        DescriptorSetLayoutConfig layoutConfig;
+        layoutConfig.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+        layoutConfig.addDescriptor(
+            bufferBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, config.stageFlags, config.bufferCapacity, bindingFlags);
+
+        // Only the last binding can have a variable count, shaders declare it as an unsized array
+        layoutConfig.addDescriptor(
+            imageBinding, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, config.stageFlags, config.imageCapacity,
+            bindingFlags | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT);
+
+        this->layout = std::make_shared<DescriptorSetLayout>(vkDeviceHandle, layoutConfig);
+
+        DescriptorPoolConfig poolConfig(1);
+        poolConfig.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+        poolConfig.addPool(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, config.bufferCapacity);
+        poolConfig.addPool(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, config.imageCapacity);
+
+        this->pool = std::make_shared<DescriptorPool>(vkDeviceHandle, poolConfig);
+        this->descriptorSet = this->pool->allocateDescriptorSet(this->layout, config.imageCapacity);
+    }
+
+
+    uint32_t BindlessTable::allocateIndex(
+        std::vector<uint32_t>& freeIndices,
+        std::size_t const usedCount,
+        uint32_t const capacity
+    ) {
+        if (!freeIndices.empty()) {
+            uint32_t const index = freeIndices.back();
+            freeIndices.pop_back();
+            return index;
+        }
+
+        if (usedCount >= capacity) {
+            throw std::runtime_error("Bindless table is full.");
+        }
+
+        return static_cast<uint32_t>(usedCount);
+    }
+
+
+    uint32_t BindlessTable::addBuffer(
+        std::shared_ptr<Buffer> const& buffer,
+        uint64_t const offset,
+        uint64_t const range
+    ) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        uint32_t const index = allocateIndex(this->freeBufferIndices, this->buffers.size(), this->config.bufferCapacity);
+
+        if (index == this->buffers.size()) {
+            this->buffers.push_back(buffer->getHandle());
+        } else {
+            this->buffers[index] = buffer->getHandle();
+        }
+
+        this->writer
+            .writeBuffer(*this->descriptorSet, bufferBinding, buffer, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, offset, range, index)
+            .flush();
+
+        return index;
+    }
+
+
+    uint32_t BindlessTable::addImage(
+        std::shared_ptr<ImageView> const& imageView,
+        VkImageLayout const imageLayout
+    ) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        uint32_t const index = allocateIndex(this->freeImageIndices, this->images.size(), this->config.imageCapacity);
+
+        if (index == this->images.size()) {
+            this->images.push_back(imageView->getHandle());
+        } else {
+            this->images[index] = imageView->getHandle();
+        }
+
+        this->writer
+            .writeImage(*this->descriptorSet, imageBinding, imageView, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, imageLayout, index)
+            .flush();
+
+        return index;
+    }
+
+
+    void BindlessTable::removeBuffer(uint32_t const index) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (index >= this->buffers.size() || this->buffers[index] == nullptr) {
+            throw std::runtime_error("Unable to remove buffer from bindless table, index is not registered.");
+        }
+
+        // The stale descriptor is left in place, partially bound slots need not be valid if unused
+        this->buffers[index] = nullptr;
+        this->freeBufferIndices.push_back(index);
+    }
+
+
+    void BindlessTable::removeImage(uint32_t const index) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (index >= this->images.size() || this->images[index] == nullptr) {
+            throw std::runtime_error("Unable to remove image from bindless table, index is not registered.");
+        }
+
+        this->images[index] = nullptr;
+        this->freeImageIndices.push_back(index);
+    }
+
+}
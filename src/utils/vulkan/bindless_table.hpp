@@ -0,0 +1,128 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/buffer.hpp"
+#include "utils/vulkan/image_view.hpp"
+#include "utils/vulkan/descriptor_pool.hpp"
+#include "utils/vulkan/descriptor_set.hpp"
+#include "utils/vulkan/descriptor_set_layout.hpp"
+#include "utils/vulkan/descriptor_writer.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Configuration struct for creating bindless tables.
+     */
+    struct BindlessTableConfig {
+        // Checked against the device's update after bind limits when the table is created
+        uint32_t bufferCapacity = 1024;
+        uint32_t imageCapacity = 4096;
+
+        // Stages which may index into the table
+        VkShaderStageFlags stageFlags = VK_SHADER_STAGE_ALL;
+    };
+
+
+    /**
+     * @brief A single descriptor set holding every registered buffer and texture, built on VK_EXT_descriptor_indexing.
+     * Resources are registered once and referenced from shaders by index, passed through push constants or
+     * instance data, so the set is bound once rather than per draw. In GLSL the table is declared as:
+     *
+     *   layout(set = N, binding = 0) readonly buffer Buffers { ... } buffers[];
+     *   layout(set = N, binding = 1) uniform texture2D textures[];
+     *
+     * Textures are sampled images, to be combined with a sampler bound elsewhere. Slots may be written while
+     * the set is bound, but a removed index must not be referenced by any frame still in flight.
+     */
+    class BindlessTable {
+    private:
+        static utils::Logger log;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+        std::shared_ptr<DescriptorSetLayout> layout;
+        std::shared_ptr<DescriptorPool> pool;
+        std::shared_ptr<DescriptorSet> descriptorSet;
+
+        mutable std::mutex mutex;
+
+        // Reused for every registration, guarded by the mutex
+        DescriptorWriter writer;
+
+        // Registered resources by index, kept alive while registered, null for free slots
+        std::vector<std::shared_ptr<BufferHandle>> buffers;
+        std::vector<std::shared_ptr<ImageViewHandle>> images;
+
+        std::vector<uint32_t> freeBufferIndices;
+        std::vector<uint32_t> freeImageIndices;
+
+    public:
+        BindlessTableConfig const config;
+
+        static uint32_t constexpr bufferBinding = 0;
+        static uint32_t constexpr imageBinding = 1;
+
+    private:
+        static uint32_t allocateIndex(
+            std::vector<uint32_t>& freeIndices,
+            std::size_t const usedCount,
+            uint32_t const capacity);
+
+    public:
+        BindlessTable(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            BindlessTableConfig const& config);
+
+        /**
+         * @brief Register a storage buffer with the table.
+         * @param buffer The buffer to register.
+         * @param offset Offset of the visible range within the buffer in bytes.
+         * @param range Size of the visible range in bytes.
+         * @return Index of the buffer within the table.
+         */
+        uint32_t addBuffer(
+            std::shared_ptr<Buffer> const& buffer,
+            uint64_t const offset = 0,
+            uint64_t const range = VK_WHOLE_SIZE);
+
+        /**
+         * @brief Register a texture with the table.
+         * @param imageView View of the texture to register.
+         * @param imageLayout Layout the image will be in when sampled.
+         * @return Index of the texture within the table.
+         */
+        uint32_t addImage(
+            std::shared_ptr<ImageView> const& imageView,
+            VkImageLayout const imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        /**
+         * @brief Unregister a buffer, freeing its index for reuse.
+         * @param index Index returned by addBuffer.
+         */
+        void removeBuffer(uint32_t const index);
+
+        /**
+         * @brief Unregister a texture, freeing its index for reuse.
+         * @param index Index returned by addImage.
+         */
+        void removeImage(uint32_t const index);
+
+        /**
+         * @brief Get the layout of the table's descriptor set, for building pipeline layouts.
+         */
+        std::shared_ptr<DescriptorSetLayout> const& getLayout() const {
+            return this->layout;
+        }
+
+        std::shared_ptr<DescriptorSet> const& getDescriptorSet() const {
+            return this->descriptorSet;
+        }
+    };
+
+}
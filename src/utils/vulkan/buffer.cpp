@@ -1,4 +1,5 @@
 #include "utils/vulkan/buffer.hpp"
+#include "utils/vulkan/pipeline_barrier.hpp"
 
 #include "vulkan/vulkan.h"
 
@@ -12,7 +13,8 @@ namespace utils::vulkan {
         VkSharingMode const sharingMode
     ) :
         HandleWrapper<BufferHandle>(std::make_shared<BufferHandle>(vkDeviceHandle)),
-        vkDeviceHandle(vkDeviceHandle)
+        vkDeviceHandle(vkDeviceHandle),
+        size(size)
     {
         VkBufferCreateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -69,4 +71,125 @@ namespace utils::vulkan {
         vkUnmapMemory(this->vkDeviceHandle->vk, this->vkDeviceMemory->vk);
         this->data = nullptr;
     }
+
+
+    void Buffer::splitRangeState(uint64_t const offset) {
+        for (unsigned i = 0; i < this->rangeStates.size(); i++) {
+            auto const range = this->rangeStates[i];
+
+            if (offset > range.offset && offset < range.offset + range.size) {
+                BufferRangeState upper = range;
+                upper.offset = offset;
+                upper.size = range.offset + range.size - offset;
+
+                this->rangeStates[i].size = offset - range.offset;
+                this->rangeStates.insert(this->rangeStates.begin() + i + 1, upper);
+                return;
+            }
+        }
+    }
+
+
+    void Buffer::mergeRangeStates() {
+        unsigned out = 0;
+
+        for (unsigned i = 1; i < this->rangeStates.size(); i++) {
+            auto& previous = this->rangeStates[out];
+            auto const& current = this->rangeStates[i];
+
+            if (previous.offset + previous.size == current.offset && previous.state == current.state) {
+                previous.size += current.size;
+            } else {
+                this->rangeStates[++out] = current;
+            }
+        }
+
+        if (!this->rangeStates.empty()) {
+            this->rangeStates.resize(out + 1);
+        }
+    }
+
+
+    ResourceState Buffer::getCombinedState() const {
+        ResourceState combined;
+
+        for (auto const& range : this->rangeStates) {
+            combined |= range.state;
+        }
+
+        return combined;
+    }
+
+
+    void Buffer::discardContents(ResourceState const& priorState) {
+        this->rangeStates.clear();
+        this->rangeStates.push_back({0, this->size, priorState});
+    }
+
+
+    void Buffer::transition(
+        PipelineBarrier& barrier,
+        AccessScope const& usage,
+        uint64_t const offset,
+        uint64_t const size
+    ) {
+        if (offset >= this->size) {
+            throw std::runtime_error("Unable to transition buffer range, offset is past the end of the buffer.");
+        }
+
+        uint64_t const end = size == VK_WHOLE_SIZE ? this->size : offset + size;
+
+        if (end > this->size) {
+            throw std::runtime_error("Unable to transition buffer range, range is past the end of the buffer.");
+        }
+
+        this->splitRangeState(offset);
+        this->splitRangeState(end);
+
+        uint64_t cursor = offset;
+        unsigned i = 0;
+
+        while (i < this->rangeStates.size() && cursor < end) {
+            auto& range = this->rangeStates[i];
+
+            if (range.offset + range.size <= cursor) {
+                i++;
+                continue;
+            }
+
+            if (range.offset >= end) {
+                break;
+            }
+
+            // Bytes in a gap have never been used, so there is nothing to wait for
+            if (range.offset > cursor) {
+                BufferRangeState gap {cursor, range.offset - cursor, ResourceState()};
+                AccessScope src;
+                transitionResourceState(gap.state, usage, false, &src);
+
+                cursor = range.offset;
+                this->rangeStates.insert(this->rangeStates.begin() + i, gap);
+                i++;
+                continue;
+            }
+
+            AccessScope src;
+            if (transitionResourceState(range.state, usage, false, &src)) {
+                barrier.addBufferBarrier(this->vkHandle->vk, src, usage, range.offset, range.size);
+            }
+
+            cursor = range.offset + range.size;
+            i++;
+        }
+
+        if (cursor < end) {
+            BufferRangeState tail {cursor, end - cursor, ResourceState()};
+            AccessScope src;
+            transitionResourceState(tail.state, usage, false, &src);
+            this->rangeStates.insert(this->rangeStates.begin() + i, tail);
+        }
+
+        this->mergeRangeStates();
+    }
+
 }
@@ -3,18 +3,35 @@
 #include "utils/misc/logging.hpp"
 #include "utils/vulkan/handles.hpp"
 #include "utils/vulkan/device_memory.hpp"
+#include "utils/vulkan/resource_state.hpp"
 
 #include <memory>
+#include <vector>
 
 
 namespace utils::vulkan {
 
+    class PipelineBarrier;
+
+
+    /**
+     * @brief Synchronization state of a byte range of a buffer.
+     */
+    struct BufferRangeState {
+        uint64_t offset;
+        uint64_t size;
+        ResourceState state;
+    };
+
+
     class Buffer : public HandleWrapper<BufferHandle> {
     private:
         static utils::Logger log;
 
         std::shared_ptr<DeviceHandle> const vkDeviceHandle;
 
+        uint64_t const size;
+
         std::shared_ptr<DeviceMemoryHandle> vkDeviceMemory = nullptr;
 
         uint64_t memoryOffset = 0;
@@ -22,6 +39,20 @@ namespace utils::vulkan {
 
         void * data = nullptr;
 
+        // Sorted, non-overlapping. Bytes not covered by a range have never been used.
+        std::vector<BufferRangeState> rangeStates;
+
+        /**
+         * @brief Split the range state containing a byte offset so that a range begins there.
+         * @param offset Offset to split at in bytes.
+         */
+        void splitRangeState(uint64_t const offset);
+
+        /**
+         * @brief Merge neighbouring range states which have identical state.
+         */
+        void mergeRangeStates();
+
     public:
         Buffer(
             std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
@@ -65,6 +96,41 @@ namespace utils::vulkan {
         uint64_t getMemorySize() {
             return this->memorySize;
         }
+
+        /**
+         * @brief Get the size the buffer was created with in bytes.
+         */
+        uint64_t getSize() const {
+            return this->size;
+        }
+
+        /**
+         * @brief Get the combined state of every range of the buffer.
+         * @return State which orders after all previous uses of the buffer.
+         */
+        ResourceState getCombinedState() const;
+
+        /**
+         * @brief Discard buffer contents, replacing all range state with a single state.
+         * Used when the buffer's memory has been aliased by another resource.
+         * @param priorState State which the next use must wait on.
+         */
+        void discardContents(ResourceState const& priorState = ResourceState());
+
+        /**
+         * @brief Record a new use of a range of the buffer, adding any barriers it requires.
+         * Parts of the range with different histories get separate barriers, and parts
+         * which need no synchronization get none.
+         * @param barrier Pipeline barrier to add buffer memory barriers to.
+         * @param usage Stages and accesses of the new use.
+         * @param offset Offset of the range in bytes.
+         * @param size Size of the range in bytes.
+         */
+        void transition(
+            PipelineBarrier& barrier,
+            AccessScope const& usage,
+            uint64_t const offset = 0,
+            uint64_t const size = VK_WHOLE_SIZE);
     };
 
 }
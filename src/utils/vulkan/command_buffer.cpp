@@ -9,10 +9,17 @@ namespace utils::vulkan {
     CommandBuffer::CommandBuffer(
         std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
         std::shared_ptr<CommandPoolHandle> const& vkCommandPoolHandle,
-        VkCommandBufferLevel const bufferLevel
-    ) : vkDeviceHandle(vkDeviceHandle), vkCommandPoolHandle(vkCommandPoolHandle) {
+        VkCommandBufferLevel const bufferLevel,
+        VkQueueFlags const queueFlags
+    ) :
+        vkDeviceHandle(vkDeviceHandle),
+        vkCommandPoolHandle(vkCommandPoolHandle),
+        supportedStages(getQueueSupportedStages(queueFlags))
+    {
         INFO(log) << "Creating command buffer." << std::endl;
 
+        this->pendingBarrier.setSupportedStages(this->supportedStages);
+
         VkCommandBufferAllocateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         createInfo.commandPool = vkCommandPoolHandle->vk;
@@ -38,6 +45,8 @@ namespace utils::vulkan {
 
 
     void CommandBuffer::end() {
+        this->flushBarriers();
+
         if (vkEndCommandBuffer(this->vk) != VK_SUCCESS) {
             throw std::runtime_error("failed to record command buffer.");
         }
@@ -45,6 +54,11 @@ namespace utils::vulkan {
 
 
     void CommandBuffer::reset() {
+        // The tracked resource states already include the transitions of the pending barrier
+        if (!this->pendingBarrier.isEmpty()) {
+            throw std::runtime_error("Unable to reset command buffer, it has barriers which were never recorded.");
+        }
+
         vkResetCommandBuffer(this->vk, 0);
     }
 
@@ -55,6 +69,8 @@ namespace utils::vulkan {
         VkOffset2D const renderOffset,
         VkExtent2D const renderExtent
     ) {
+        this->flushBarriers();
+
         VkClearValue clearValues = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
 
         VkRenderPassBeginInfo renderPassInfo {};
@@ -80,6 +96,11 @@ namespace utils::vulkan {
     }
 
 
+    void CommandBuffer::bindComputePipeline(std::shared_ptr<ComputePipeline> const& computePipeline) {
+        vkCmdBindPipeline(this->vk, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline->getHandle()->vk);
+    }
+
+
     void CommandBuffer::setViewport(VkExtent2D const renderExtent) {
         VkViewport viewPort {};
         viewPort.x = 0.0f;
@@ -100,6 +121,139 @@ namespace utils::vulkan {
     }
 
 
+    void CommandBuffer::setCullMode(VkCullModeFlags const cullMode) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetCullMode;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set cull mode, VK_EXT_extended_dynamic_state is not enabled.");
+        }
+
+        cmd(this->vk, cullMode);
+    }
+
+
+    void CommandBuffer::setFrontFace(VkFrontFace const frontFace) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetFrontFace;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set front face, VK_EXT_extended_dynamic_state is not enabled.");
+        }
+
+        cmd(this->vk, frontFace);
+    }
+
+
+    void CommandBuffer::setPrimitiveTopology(VkPrimitiveTopology const topology) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetPrimitiveTopology;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set primitive topology, VK_EXT_extended_dynamic_state is not enabled.");
+        }
+
+        cmd(this->vk, topology);
+    }
+
+
+    void CommandBuffer::setDepthTestEnable(bool const enable) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetDepthTestEnable;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set depth test enable, VK_EXT_extended_dynamic_state is not enabled.");
+        }
+
+        cmd(this->vk, enable ? VK_TRUE : VK_FALSE);
+    }
+
+
+    void CommandBuffer::setDepthWriteEnable(bool const enable) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetDepthWriteEnable;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set depth write enable, VK_EXT_extended_dynamic_state is not enabled.");
+        }
+
+        cmd(this->vk, enable ? VK_TRUE : VK_FALSE);
+    }
+
+
+    void CommandBuffer::setDepthCompareOp(VkCompareOp const compareOp) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetDepthCompareOp;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set depth compare op, VK_EXT_extended_dynamic_state is not enabled.");
+        }
+
+        cmd(this->vk, compareOp);
+    }
+
+
+    void CommandBuffer::setDepthBiasEnable(bool const enable) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetDepthBiasEnable;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set depth bias enable, VK_EXT_extended_dynamic_state2 is not enabled.");
+        }
+
+        cmd(this->vk, enable ? VK_TRUE : VK_FALSE);
+    }
+
+
+    void CommandBuffer::setPrimitiveRestartEnable(bool const enable) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetPrimitiveRestartEnable;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set primitive restart enable, VK_EXT_extended_dynamic_state2 is not enabled.");
+        }
+
+        cmd(this->vk, enable ? VK_TRUE : VK_FALSE);
+    }
+
+
+    void CommandBuffer::setRasterizerDiscardEnable(bool const enable) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetRasterizerDiscardEnable;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set rasterizer discard enable, VK_EXT_extended_dynamic_state2 is not enabled.");
+        }
+
+        cmd(this->vk, enable ? VK_TRUE : VK_FALSE);
+    }
+
+
+    void CommandBuffer::setPolygonMode(VkPolygonMode const polygonMode) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetPolygonMode;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set polygon mode, VK_EXT_extended_dynamic_state3 (polygon mode) is not enabled.");
+        }
+
+        cmd(this->vk, polygonMode);
+    }
+
+
+    void CommandBuffer::setColorBlendEnable(bool const enable) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetColorBlendEnable;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set color blend enable, VK_EXT_extended_dynamic_state3 (color blend enable) is not enabled.");
+        }
+
+        VkBool32 const blendEnable = enable ? VK_TRUE : VK_FALSE;
+        cmd(this->vk, 0, 1, &blendEnable);
+    }
+
+
+    void CommandBuffer::setColorWriteMask(VkColorComponentFlags const colorWriteMask) {
+        auto const cmd = this->vkDeviceHandle->functions.vkCmdSetColorWriteMask;
+
+        if (cmd == nullptr) {
+            throw std::runtime_error("Unable to set color write mask, VK_EXT_extended_dynamic_state3 (color write mask) is not enabled.");
+        }
+
+        cmd(this->vk, 0, 1, &colorWriteMask);
+    }
+
+
     void CommandBuffer::draw(
         uint32_t const vertexCount,
         uint32_t const instanceCount,
@@ -121,24 +275,185 @@ namespace utils::vulkan {
     }
 
 
+    void CommandBuffer::drawIndirect(
+        std::shared_ptr<Buffer> const& buffer,
+        uint64_t const offset,
+        uint32_t const drawCount,
+        uint32_t const stride
+    ) {
+        vkCmdDrawIndirect(this->vk, buffer->getHandle()->vk, offset, drawCount, stride);
+    }
+
+
+    void CommandBuffer::drawIndexedIndirect(
+        std::shared_ptr<Buffer> const& buffer,
+        uint64_t const offset,
+        uint32_t const drawCount,
+        uint32_t const stride
+    ) {
+        vkCmdDrawIndexedIndirect(this->vk, buffer->getHandle()->vk, offset, drawCount, stride);
+    }
+
+
+    void CommandBuffer::drawIndirectCount(
+        std::shared_ptr<Buffer> const& buffer,
+        uint64_t const offset,
+        std::shared_ptr<Buffer> const& countBuffer,
+        uint64_t const countBufferOffset,
+        uint32_t const maxDrawCount,
+        uint32_t const stride
+    ) {
+        auto const cmdDrawIndirectCount = this->vkDeviceHandle->functions.vkCmdDrawIndirectCount;
+
+        if (cmdDrawIndirectCount == nullptr) {
+            throw std::runtime_error("Unable to draw indirect count, VK_KHR_draw_indirect_count is not enabled.");
+        }
+
+        cmdDrawIndirectCount(
+            this->vk,
+            buffer->getHandle()->vk, offset,
+            countBuffer->getHandle()->vk, countBufferOffset,
+            maxDrawCount, stride);
+    }
+
+
+    void CommandBuffer::drawIndexedIndirectCount(
+        std::shared_ptr<Buffer> const& buffer,
+        uint64_t const offset,
+        std::shared_ptr<Buffer> const& countBuffer,
+        uint64_t const countBufferOffset,
+        uint32_t const maxDrawCount,
+        uint32_t const stride
+    ) {
+        auto const cmdDrawIndexedIndirectCount = this->vkDeviceHandle->functions.vkCmdDrawIndexedIndirectCount;
+
+        if (cmdDrawIndexedIndirectCount == nullptr) {
+            throw std::runtime_error("Unable to draw indexed indirect count, VK_KHR_draw_indirect_count is not enabled.");
+        }
+
+        cmdDrawIndexedIndirectCount(
+            this->vk,
+            buffer->getHandle()->vk, offset,
+            countBuffer->getHandle()->vk, countBufferOffset,
+            maxDrawCount, stride);
+    }
+
+
+    void CommandBuffer::dispatch(
+        uint32_t const groupCountX,
+        uint32_t const groupCountY,
+        uint32_t const groupCountZ
+    ) {
+        this->flushBarriers();
+        vkCmdDispatch(this->vk, groupCountX, groupCountY, groupCountZ);
+    }
+
+
+    void CommandBuffer::dispatchIndirect(
+        std::shared_ptr<Buffer> const& buffer,
+        uint64_t const offset
+    ) {
+        this->useBuffer(
+            buffer,
+            {VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT},
+            offset, sizeof(VkDispatchIndirectCommand));
+
+        this->flushBarriers();
+        vkCmdDispatchIndirect(this->vk, buffer->getHandle()->vk, offset);
+    }
+
+
     void CommandBuffer::bindDescriptorSet(
         std::shared_ptr<DescriptorSet> const& descriptorSet,
         std::shared_ptr<PipelineLayout> const& pipelineLayout,
-        VkPipelineBindPoint const bindPoint
+        VkPipelineBindPoint const bindPoint,
+        uint32_t const setIndex,
+        std::vector<uint32_t> const& dynamicOffsets
+    ) {
+        vkCmdBindDescriptorSets(
+            this->vk, bindPoint, pipelineLayout->getHandle()->vk,
+            setIndex, 1, &descriptorSet->vk,
+            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+    }
+
+
+    void CommandBuffer::bindDescriptorSets(
+        std::vector<std::shared_ptr<DescriptorSet>> const& descriptorSets,
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        VkPipelineBindPoint const bindPoint,
+        uint32_t const firstSet,
+        std::vector<uint32_t> const& dynamicOffsets
+    ) {
+        if (descriptorSets.size() > maxDescriptorSetBindings) {
+            throw std::runtime_error("Unable to bind descriptor sets, too many sets.");
+        }
+
+        VkDescriptorSet sets[maxDescriptorSetBindings];
+
+        for (unsigned i = 0; i < descriptorSets.size(); i++) {
+            sets[i] = descriptorSets[i]->vk;
+        }
+
+        vkCmdBindDescriptorSets(
+            this->vk, bindPoint, pipelineLayout->getHandle()->vk,
+            firstSet, static_cast<uint32_t>(descriptorSets.size()), sets,
+            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+    }
+
+
+    void CommandBuffer::pushConstants(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        VkShaderStageFlags const stageFlags,
+        uint32_t const offset,
+        uint32_t const size,
+        void const * const data
     ) {
-        vkCmdBindDescriptorSets(this->vk, bindPoint, pipelineLayout->getHandle()->vk, 0, 1, &descriptorSet->vk, 0, nullptr);
+        vkCmdPushConstants(this->vk, pipelineLayout->getHandle()->vk, stageFlags, offset, size, data);
     }
 
 
-    void CommandBuffer::bindVertexBuffer(std::shared_ptr<Buffer> const& vertexBuffer) {
-        VkBuffer vertexBuffers[] = {vertexBuffer->getHandle()->vk};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(this->vk, 0, 1, vertexBuffers, offsets);
+    void CommandBuffer::bindVertexBuffer(
+        std::shared_ptr<Buffer> const& vertexBuffer,
+        uint32_t const binding,
+        uint64_t const offset
+    ) {
+        VkBuffer const buffer = vertexBuffer->getHandle()->vk;
+        VkDeviceSize const bufferOffset = offset;
+        vkCmdBindVertexBuffers(this->vk, binding, 1, &buffer, &bufferOffset);
     }
 
 
-    void CommandBuffer::bindIndexBuffer(std::shared_ptr<Buffer> const& indexBuffer, VkIndexType const indexType) {
-        vkCmdBindIndexBuffer(this->vk, indexBuffer->getHandle()->vk, 0, indexType);
+    void CommandBuffer::bindVertexBuffers(
+        uint32_t const firstBinding,
+        std::vector<std::shared_ptr<Buffer>> const& vertexBuffers,
+        std::vector<uint64_t> const& offsets
+    ) {
+        if (vertexBuffers.size() != offsets.size()) {
+            throw std::runtime_error("Unable to bind vertex buffers, buffer count does not match offset count.");
+        }
+
+        if (vertexBuffers.size() > maxVertexBufferBindings) {
+            throw std::runtime_error("Unable to bind vertex buffers, too many buffers.");
+        }
+
+        VkBuffer buffers[maxVertexBufferBindings];
+        VkDeviceSize bufferOffsets[maxVertexBufferBindings];
+
+        for (unsigned i = 0; i < vertexBuffers.size(); i++) {
+            buffers[i] = vertexBuffers[i]->getHandle()->vk;
+            bufferOffsets[i] = offsets[i];
+        }
+
+        vkCmdBindVertexBuffers(this->vk, firstBinding, static_cast<uint32_t>(vertexBuffers.size()), buffers, bufferOffsets);
+    }
+
+
+    void CommandBuffer::bindIndexBuffer(
+        std::shared_ptr<Buffer> const& indexBuffer,
+        VkIndexType const indexType,
+        uint64_t const offset
+    ) {
+        vkCmdBindIndexBuffer(this->vk, indexBuffer->getHandle()->vk, offset, indexType);
     }
 
 
@@ -149,6 +464,10 @@ namespace utils::vulkan {
         uint64_t const destinationOffset,
         uint64_t const size
     ) {
+        this->useBuffer(sourceBuffer, {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT}, sourceOffset, size);
+        this->useBuffer(destinationBuffer, {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT}, destinationOffset, size);
+        this->flushBarriers();
+
         VkBufferCopy copyRegion {};
         copyRegion.srcOffset = sourceOffset;
         copyRegion.dstOffset = destinationOffset;
@@ -162,23 +481,74 @@ namespace utils::vulkan {
         std::shared_ptr<Buffer> const& sourceBuffer,
         std::shared_ptr<Buffer> const& destinationBuffer
     ) {
-        if (sourceBuffer->getMemorySize() != destinationBuffer->getMemorySize()) {
+        if (sourceBuffer->getSize() != destinationBuffer->getSize()) {
             throw std::runtime_error("Unable to perform full buffer copy, source and destination buffers differ in size.");
         }
 
-        this->copyBuffer(sourceBuffer, destinationBuffer, 0, 0, sourceBuffer->getMemorySize());
+        this->copyBuffer(sourceBuffer, destinationBuffer, 0, 0, sourceBuffer->getSize());
+    }
+
+
+    void CommandBuffer::useImage(
+        std::shared_ptr<Image> const& image,
+        VkImageSubresourceRange const& range,
+        VkImageLayout const layout,
+        AccessScope const& usage
+    ) {
+        image->transition(this->pendingBarrier, range, layout, usage);
+    }
+
+
+    void CommandBuffer::useImage(
+        std::shared_ptr<Image> const& image,
+        VkImageLayout const layout,
+        AccessScope const& usage
+    ) {
+        image->transition(this->pendingBarrier, image->getFullRange(), layout, usage);
+    }
+
+
+    void CommandBuffer::useBuffer(
+        std::shared_ptr<Buffer> const& buffer,
+        AccessScope const& usage,
+        uint64_t const offset,
+        uint64_t const size
+    ) {
+        buffer->transition(this->pendingBarrier, usage, offset, size);
+    }
+
+
+    void CommandBuffer::flushBarriers() {
+        if (this->pendingBarrier.isEmpty()) {
+            return;
+        }
+
+        this->pendingBarrier.record(this->vk);
+        this->pendingBarrier.clear();
     }
 
 
     void CommandBuffer::pipelineBarrier(VkImageMemoryBarrier const& barrier) {
+        auto const src = restrictScopeToStages(getImageLayoutSourceScope(barrier.oldLayout), this->supportedStages);
+        auto const dst = restrictScopeToStages(getImageLayoutDestinationScope(barrier.newLayout), this->supportedStages);
+
+        VkImageMemoryBarrier completeBarrier = barrier;
+        completeBarrier.srcAccessMask = src.access;
+        completeBarrier.dstAccessMask = dst.access;
+
         vkCmdPipelineBarrier(
             this->vk,
-            0, // TODO
-            0, // TODO
+            src.stages != 0 ? src.stages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            dst.stages != 0 ? dst.stages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
             0,
             0, nullptr,
             0, nullptr,
-            1, &barrier
+            1, &completeBarrier
         );
     }
+
+
+    void CommandBuffer::pipelineBarrier(PipelineBarrier const& barrier) {
+        barrier.record(this->vk);
+    }
 }
@@ -5,10 +5,12 @@
 #include "utils/vulkan/render_pass.hpp"
 #include "utils/vulkan/frame_buffer.hpp"
 #include "utils/vulkan/graphics_pipeline.hpp"
+#include "utils/vulkan/compute_pipeline.hpp"
 #include "utils/vulkan/buffer.hpp"
 #include "utils/vulkan/descriptor_set.hpp"
 #include "utils/vulkan/pipeline_layout.hpp"
 #include "utils/vulkan/image.hpp"
+#include "utils/vulkan/pipeline_barrier.hpp"
 
 
 namespace utils::vulkan {
@@ -17,9 +19,21 @@ namespace utils::vulkan {
     private:
         static utils::Logger log;
 
+        // Minimum value of maxVertexInputBindings guaranteed by the spec
+        static uint32_t constexpr maxVertexBufferBindings = 16;
+
+        // Upper bound on descriptor sets bound in one call, the spec minimum is 4
+        static uint32_t constexpr maxDescriptorSetBindings = 32;
+
         std::shared_ptr<DeviceHandle> const vkDeviceHandle;
         std::shared_ptr<CommandPoolHandle> const vkCommandPoolHandle;
 
+        // Pipeline stages supported by the queue family of the command pool
+        VkPipelineStageFlags const supportedStages;
+
+        // Barriers required by resource uses which have not been recorded yet
+        PipelineBarrier pendingBarrier;
+
     public:
         VkCommandBuffer_T * vk;
 
@@ -27,7 +41,8 @@ namespace utils::vulkan {
         CommandBuffer(
             std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
             std::shared_ptr<CommandPoolHandle> const& vkCommandPoolHandle,
-            VkCommandBufferLevel const bufferLevel);
+            VkCommandBufferLevel const bufferLevel,
+            VkQueueFlags const queueFlags);
 
         /**
          * @brief Begin writing to the command buffer.
@@ -36,17 +51,22 @@ namespace utils::vulkan {
         void begin(VkCommandBufferUsageFlagBits const flags = static_cast<VkCommandBufferUsageFlagBits>(0));
 
         /**
-         * @brief Finalize the command buffer.
+         * @brief Finalize the command buffer, flushing any pending barriers.
          */
         void end();
 
         /**
          * @brief Reset the command buffer so that it can be re-recorded.
+         * Throws if barriers from useImage/useBuffer are still pending, as the resources already
+         * track the state those barriers transition to. Resetting a recorded command buffer without
+         * submitting it leaves the tracked state out of sync in the same way.
          */
         void reset();
 
         /**
-         * @brief Begin render pass.
+         * @brief Begin render pass, flushing any pending barriers first.
+         * Barriers cannot be recorded inside a render pass, so resources used by draws
+         * should be declared with useImage/useBuffer before the render pass begins.
          * @param renderPass Shared pointer to render pass object.
          * @param frameBuffer Shared pointer to frame buffer for rendering.
          * @param renderOffset Offset to begin rendering at.
@@ -69,6 +89,12 @@ namespace utils::vulkan {
          */
         void bindGraphicsPipeline(std::shared_ptr<GraphicsPipeline> const& graphicsPipeline);
 
+        /**
+         * @brief Bind compute pipeline
+         * @param computePipeline Shared pointer to compute pipeline object.
+         */
+        void bindComputePipeline(std::shared_ptr<ComputePipeline> const& computePipeline);
+
         /**
          * @brief Set viewport settings.
          * @param renderExtent Extent of the viewport.
@@ -82,6 +108,80 @@ namespace utils::vulkan {
          */
         void setScissor(VkOffset2D const scissorOffset, VkExtent2D const scissorExtent);
 
+        /**
+         * The setters below require the corresponding state to be dynamic in the bound pipeline
+         * (see GraphicsPipelineConfig::addDynamicState), and throw if the extension providing
+         * them is not enabled. Cull mode through depth compare op need VK_EXT_extended_dynamic_state,
+         * depth bias, primitive restart and rasterizer discard need VK_EXT_extended_dynamic_state2,
+         * polygon mode, blend enable and write mask need VK_EXT_extended_dynamic_state3.
+         */
+
+        /**
+         * @brief Set the cull mode.
+         * @param cullMode Faces to cull (e.g. VK_CULL_MODE_BACK_BIT).
+         */
+        void setCullMode(VkCullModeFlags const cullMode);
+
+        /**
+         * @brief Set which winding order is considered front facing.
+         * @param frontFace Front face winding order.
+         */
+        void setFrontFace(VkFrontFace const frontFace);
+
+        /**
+         * @brief Set the primitive topology.
+         * @param topology Topology, must be in the same class as the pipeline's topology.
+         */
+        void setPrimitiveTopology(VkPrimitiveTopology const topology);
+
+        /**
+         * @brief Enable or disable depth testing.
+         */
+        void setDepthTestEnable(bool const enable);
+
+        /**
+         * @brief Enable or disable depth writes.
+         */
+        void setDepthWriteEnable(bool const enable);
+
+        /**
+         * @brief Set the depth comparison operator.
+         * @param compareOp Comparison used for the depth test.
+         */
+        void setDepthCompareOp(VkCompareOp const compareOp);
+
+        /**
+         * @brief Enable or disable depth bias.
+         */
+        void setDepthBiasEnable(bool const enable);
+
+        /**
+         * @brief Enable or disable primitive restart.
+         */
+        void setPrimitiveRestartEnable(bool const enable);
+
+        /**
+         * @brief Enable or disable rasterizer discard.
+         */
+        void setRasterizerDiscardEnable(bool const enable);
+
+        /**
+         * @brief Set the polygon mode.
+         * @param polygonMode Polygon mode (e.g. VK_POLYGON_MODE_LINE for wireframe).
+         */
+        void setPolygonMode(VkPolygonMode const polygonMode);
+
+        /**
+         * @brief Enable or disable blending on the color attachment.
+         */
+        void setColorBlendEnable(bool const enable);
+
+        /**
+         * @brief Set the color write mask of the color attachment.
+         * @param colorWriteMask Color components to write.
+         */
+        void setColorWriteMask(VkColorComponentFlags const colorWriteMask);
+
         /**
          * @brief Draw some stuff!
          * @param vertexCount Number of vertices to render.
@@ -110,32 +210,188 @@ namespace utils::vulkan {
             int32_t const vertexOffset,
             uint32_t const firstInstance);
 
+        /**
+         * @brief Draw some stuff, with draw parameters read from a buffer.
+         * @param buffer Shared pointer to buffer containing VkDrawIndirectCommand structures.
+         * @param offset Offset of the first command within the buffer in bytes.
+         * @param drawCount Number of draws to execute.
+         * @param stride Distance between successive commands in bytes.
+         */
+        void drawIndirect(
+            std::shared_ptr<Buffer> const& buffer,
+            uint64_t const offset,
+            uint32_t const drawCount,
+            uint32_t const stride = sizeof(VkDrawIndirectCommand));
+
+        /**
+         * @brief Draw some stuff (indexed), with draw parameters read from a buffer.
+         * @param buffer Shared pointer to buffer containing VkDrawIndexedIndirectCommand structures.
+         * @param offset Offset of the first command within the buffer in bytes.
+         * @param drawCount Number of draws to execute.
+         * @param stride Distance between successive commands in bytes.
+         */
+        void drawIndexedIndirect(
+            std::shared_ptr<Buffer> const& buffer,
+            uint64_t const offset,
+            uint32_t const drawCount,
+            uint32_t const stride = sizeof(VkDrawIndexedIndirectCommand));
+
+        /**
+         * @brief Draw some stuff, with draw parameters and draw count read from buffers.
+         * Requires the VK_KHR_draw_indirect_count device extension. See Device::supportsDrawIndirectCount.
+         * @param buffer Shared pointer to buffer containing VkDrawIndirectCommand structures.
+         * @param offset Offset of the first command within the buffer in bytes.
+         * @param countBuffer Shared pointer to buffer containing the draw count.
+         * @param countBufferOffset Offset of the draw count within the count buffer in bytes.
+         * @param maxDrawCount Upper limit on the number of draws to execute.
+         * @param stride Distance between successive commands in bytes.
+         */
+        void drawIndirectCount(
+            std::shared_ptr<Buffer> const& buffer,
+            uint64_t const offset,
+            std::shared_ptr<Buffer> const& countBuffer,
+            uint64_t const countBufferOffset,
+            uint32_t const maxDrawCount,
+            uint32_t const stride = sizeof(VkDrawIndirectCommand));
+
+        /**
+         * @brief Draw some stuff (indexed), with draw parameters and draw count read from buffers.
+         * Requires the VK_KHR_draw_indirect_count device extension. See Device::supportsDrawIndirectCount.
+         * @param buffer Shared pointer to buffer containing VkDrawIndexedIndirectCommand structures.
+         * @param offset Offset of the first command within the buffer in bytes.
+         * @param countBuffer Shared pointer to buffer containing the draw count.
+         * @param countBufferOffset Offset of the draw count within the count buffer in bytes.
+         * @param maxDrawCount Upper limit on the number of draws to execute.
+         * @param stride Distance between successive commands in bytes.
+         */
+        void drawIndexedIndirectCount(
+            std::shared_ptr<Buffer> const& buffer,
+            uint64_t const offset,
+            std::shared_ptr<Buffer> const& countBuffer,
+            uint64_t const countBufferOffset,
+            uint32_t const maxDrawCount,
+            uint32_t const stride = sizeof(VkDrawIndexedIndirectCommand));
+
+        /**
+         * @brief Dispatch compute work, flushing any pending barriers first.
+         * @param groupCountX Number of workgroups to dispatch in the X dimension.
+         * @param groupCountY Number of workgroups to dispatch in the Y dimension.
+         * @param groupCountZ Number of workgroups to dispatch in the Z dimension.
+         */
+        void dispatch(
+            uint32_t const groupCountX,
+            uint32_t const groupCountY = 1,
+            uint32_t const groupCountZ = 1);
+
+        /**
+         * @brief Dispatch compute work, with workgroup counts read from a buffer.
+         * The read of the parameters is tracked like useBuffer, and pending barriers are flushed.
+         * @param buffer Shared pointer to buffer containing a VkDispatchIndirectCommand structure.
+         * @param offset Offset of the command within the buffer in bytes.
+         */
+        void dispatchIndirect(
+            std::shared_ptr<Buffer> const& buffer,
+            uint64_t const offset = 0);
+
         /**
          * @brief Bind a descriptor set.
          * @param descriptorSet Shared pointer to descriptor set to bind.
          * @param pipelineLayout Shared pointer to pipeline layout object.
          * @param bindPoint Bind point for the (e.g. VK_PIPELINE_BIND_POINT_GRAPHICS)
+         * @param setIndex Index of the set within the pipeline layout.
+         * @param dynamicOffsets Offsets for each dynamic descriptor in the set, in binding order.
          */
         void bindDescriptorSet(
             std::shared_ptr<DescriptorSet> const& descriptorSet,
             std::shared_ptr<PipelineLayout> const& pipelineLayout,
-            VkPipelineBindPoint const bindPoint);
+            VkPipelineBindPoint const bindPoint,
+            uint32_t const setIndex = 0,
+            std::vector<uint32_t> const& dynamicOffsets = {});
+
+        /**
+         * @brief Bind several descriptor sets to consecutive set indices.
+         * @param descriptorSets Vector of shared pointers to descriptor sets to bind.
+         * @param pipelineLayout Shared pointer to pipeline layout object.
+         * @param bindPoint Bind point for the (e.g. VK_PIPELINE_BIND_POINT_GRAPHICS)
+         * @param firstSet Index of the first set within the pipeline layout.
+         * @param dynamicOffsets Offsets for each dynamic descriptor, in set then binding order.
+         */
+        void bindDescriptorSets(
+            std::vector<std::shared_ptr<DescriptorSet>> const& descriptorSets,
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            VkPipelineBindPoint const bindPoint,
+            uint32_t const firstSet = 0,
+            std::vector<uint32_t> const& dynamicOffsets = {});
+
+        /**
+         * @brief Update push constant values.
+         * @param pipelineLayout Shared pointer to pipeline layout declaring the push constant range.
+         * @param stageFlags Shader stages that will use the updated values.
+         * @param offset Offset of the first byte to update in bytes.
+         * @param size Number of bytes to update.
+         * @param data Pointer to the new push constant values.
+         */
+        void pushConstants(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            VkShaderStageFlags const stageFlags,
+            uint32_t const offset,
+            uint32_t const size,
+            void const * const data);
+
+        /**
+         * @brief Update push constant values from a value of type T.
+         * @param pipelineLayout Shared pointer to pipeline layout declaring the push constant range.
+         * @param stageFlags Shader stages that will use the updated values.
+         * @param value Value to copy into the push constant range.
+         * @param offset Offset of the first byte to update in bytes.
+         */
+        template<typename T>
+        void pushConstants(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            VkShaderStageFlags const stageFlags,
+            T const& value,
+            uint32_t const offset = 0
+        ) {
+            pushConstants(pipelineLayout, stageFlags, offset, sizeof(T), &value);
+        }
 
         /**
          * @brief Bind a single vertex buffer.
          * @param vertexBuffer Pointer to vertex buffer.
+         * @param binding Vertex input binding to bind the buffer to.
+         * @param offset Offset of the vertex data within the buffer in bytes.
          */
-        void bindVertexBuffer(std::shared_ptr<Buffer> const& vertexBuffer);
+        void bindVertexBuffer(
+            std::shared_ptr<Buffer> const& vertexBuffer,
+            uint32_t const binding = 0,
+            uint64_t const offset = 0);
+
+        /**
+         * @brief Bind several vertex buffers to consecutive bindings.
+         * Buffers may be repeated with different offsets to bind several ranges of a single buffer.
+         * @param firstBinding Vertex input binding to bind the first buffer to.
+         * @param vertexBuffers Vector of shared pointers to vertex buffers.
+         * @param offsets Offset of the vertex data within each buffer in bytes.
+         */
+        void bindVertexBuffers(
+            uint32_t const firstBinding,
+            std::vector<std::shared_ptr<Buffer>> const& vertexBuffers,
+            std::vector<uint64_t> const& offsets);
 
         /**
          * @brief Bind an index buffer.
          * @param indexBuffer Shared pointer to index buffer.
          * @param indexType The datatype of the indices.
+         * @param offset Offset of the index data within the buffer in bytes.
          */
-        void bindIndexBuffer(std::shared_ptr<Buffer> const& indexBuffer, VkIndexType const indexType);
+        void bindIndexBuffer(
+            std::shared_ptr<Buffer> const& indexBuffer,
+            VkIndexType const indexType,
+            uint64_t const offset = 0);
 
         /**
          * @brief Copy a subsection of one buffer to a subsection of another buffer.
+         * Both ranges are tracked, and any barriers they need are recorded before the copy.
          * @param sourceBuffer Shared pointer to the source buffer.
          * @param destinationBuffer Shared pointer to destination buffer.
          * @param sourceOffset Offset to start copying from the source buffer.
@@ -158,11 +414,68 @@ namespace utils::vulkan {
             std::shared_ptr<Buffer> const& sourceBuffer,
             std::shared_ptr<Buffer> const& destinationBuffer);
 
+        /**
+         * @brief Declare a use of an image subresource range.
+         * Adds whatever barrier the use needs to the pending barrier, based on the state
+         * tracked by the image. Resource state is tracked at record time, so command buffers
+         * must be submitted in the order they were recorded, and not be reset or discarded
+         * without being submitted.
+         * @param image Shared pointer to the image.
+         * @param range Subresource range being used.
+         * @param layout Layout the subresources must be in.
+         * @param usage Stages and accesses of the use.
+         */
+        void useImage(
+            std::shared_ptr<Image> const& image,
+            VkImageSubresourceRange const& range,
+            VkImageLayout const layout,
+            AccessScope const& usage);
+
+        /**
+         * @brief Declare a use of every subresource of an image.
+         * @param image Shared pointer to the image.
+         * @param layout Layout the image must be in.
+         * @param usage Stages and accesses of the use.
+         */
+        void useImage(
+            std::shared_ptr<Image> const& image,
+            VkImageLayout const layout,
+            AccessScope const& usage);
+
+        /**
+         * @brief Declare a use of a buffer range.
+         * Adds whatever barrier the use needs to the pending barrier, based on the state
+         * tracked by the buffer. As with useImage, the command buffer must be submitted.
+         * @param buffer Shared pointer to the buffer.
+         * @param usage Stages and accesses of the use.
+         * @param offset Offset of the range in bytes.
+         * @param size Size of the range in bytes.
+         */
+        void useBuffer(
+            std::shared_ptr<Buffer> const& buffer,
+            AccessScope const& usage,
+            uint64_t const offset = 0,
+            uint64_t const size = VK_WHOLE_SIZE);
+
+        /**
+         * @brief Record pending barriers from useImage/useBuffer as a single pipeline barrier.
+         * Called automatically before copies, render passes and at the end of recording.
+         */
+        void flushBarriers();
+
         /**
          * @brief Perform an image memory barrier.
+         * Stage and access masks are derived from the old and new layouts of the barrier,
+         * restricted to the stages supported by the queue family of the command pool.
          * @param barrier VkImageMemoryBarrier instance.
          */
         void pipelineBarrier(VkImageMemoryBarrier const& barrier);
+
+        /**
+         * @brief Record a batch of memory, buffer and image barriers with a single command.
+         * @param barrier Pipeline barrier object containing the barriers to record.
+         */
+        void pipelineBarrier(PipelineBarrier const& barrier);
     };
 
 }
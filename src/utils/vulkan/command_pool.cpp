@@ -10,10 +10,12 @@ namespace utils::vulkan {
 
     CommandPool::CommandPool(
         std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
-        CommandPoolConfig const& config
+        CommandPoolConfig const& config,
+        VkQueueFlags const queueFlags
     ) :
         HandleWrapper<CommandPoolHandle>(std::make_shared<CommandPoolHandle>(vkDeviceHandle)),
-        vkDeviceHandle(vkDeviceHandle)
+        vkDeviceHandle(vkDeviceHandle),
+        queueFlags(queueFlags)
     {
         INFO(log) << "Creating command pool." << std::endl;
 
@@ -29,7 +31,7 @@ namespace utils::vulkan {
 
 
     std::shared_ptr<CommandBuffer> CommandPool::allocateCommandBuffer(VkCommandBufferLevel const flags) const {
-        return std::make_shared<CommandBuffer>(this->vkDeviceHandle, this->vkHandle, flags);
+        return std::make_shared<CommandBuffer>(this->vkDeviceHandle, this->vkHandle, flags, this->queueFlags);
     }
 
 }
@@ -23,8 +23,14 @@ namespace utils::vulkan {
 
         std::shared_ptr<DeviceHandle> const vkDeviceHandle;
 
+        // Capabilities of the queue family, barriers recorded into the command buffers are restricted to them
+        VkQueueFlags const queueFlags;
+
     public:
-        CommandPool(std::shared_ptr<DeviceHandle> const& vkDeviceHandle, CommandPoolConfig const& config);
+        CommandPool(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            CommandPoolConfig const& config,
+            VkQueueFlags const queueFlags);
 
         /**
          * @brief Create a new command buffer.
@@ -0,0 +1,43 @@
+#include "utils/vulkan/compute_pipeline.hpp"
+
+
+namespace utils::vulkan {
+
+    utils::Logger ComputePipeline::log("ComputePipeline");
+
+
+    ComputePipeline::ComputePipeline(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
+        std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
+        ComputePipelineConfig const& config
+    ) :
+        HandleWrapper<PipelineHandle>(std::make_shared<PipelineHandle>(vkDeviceHandle)),
+        vkDeviceHandle(vkDeviceHandle),
+        vkPipelineCacheHandle(vkPipelineCacheHandle),
+        vkPipelineLayoutHandle(vkPipelineLayoutHandle),
+        config(config)
+    {
+        INFO(log) << "Creating new compute pipeline." << std::endl;
+
+        if (!config.shaderStage) {
+            throw std::runtime_error("Unable to create compute pipeline, no shader was specified.");
+        }
+
+        VkSpecializationInfo specializationInfo {};
+
+        VkComputePipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage = this->config.shaderStage->toVulkan(specializationInfo);
+        pipelineInfo.layout = this->vkPipelineLayoutHandle->vk;
+        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;       // Optional
+        pipelineInfo.basePipelineIndex = -1;                    // Optional
+
+        VkPipelineCache const pipelineCache = this->vkPipelineCacheHandle != nullptr ? this->vkPipelineCacheHandle->vk : VK_NULL_HANDLE;
+
+        if (vkCreateComputePipelines(this->vkDeviceHandle->vk, pipelineCache, 1, &pipelineInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute pipeline.");
+        }
+    }
+
+}
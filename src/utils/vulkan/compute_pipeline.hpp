@@ -0,0 +1,67 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/graphics_pipeline.hpp"
+
+#include <optional>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Helper object for configuring compute pipeline.
+     */
+    struct ComputePipelineConfig {
+        std::optional<ShaderStageConfig> shaderStage;
+
+        /**
+         * @brief Set the compute shader.
+         * @param shaderModule Shared pointer to shader module handle.
+         * @param shaderMain String containing name of the main function in the shader.
+         */
+        ComputePipelineConfig& setShader(
+            std::shared_ptr<ShaderModuleHandle> const& shaderModule,
+            std::string const& shaderMain = "main"
+        ) {
+            shaderStage.emplace(ShaderStageConfig{shaderModule, VK_SHADER_STAGE_COMPUTE_BIT, shaderMain});
+            return *this;
+        }
+
+        /**
+         * @brief Set a specialization constant on the compute shader (e.g. a workgroup size).
+         * @param constantId Constant id in the shader.
+         * @param value Value to bake into the pipeline.
+         */
+        template<typename T>
+        ComputePipelineConfig& setSpecializationConstant(uint32_t const constantId, T const value) {
+            if (!shaderStage) {
+                throw std::runtime_error("Failed to set specialization constant: No compute shader set.");
+            }
+
+            shaderStage->setSpecializationConstant(constantId, value);
+            return *this;
+        }
+    };
+
+
+    class ComputePipeline : public HandleWrapper<PipelineHandle> {
+    private:
+        static utils::Logger log;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+        std::shared_ptr<PipelineCacheHandle> const vkPipelineCacheHandle;
+        std::shared_ptr<PipelineLayoutHandle> const vkPipelineLayoutHandle;
+
+        ComputePipelineConfig const config;
+
+    public:
+        ComputePipeline(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
+            std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
+            ComputePipelineConfig const& config);
+
+    };
+
+}
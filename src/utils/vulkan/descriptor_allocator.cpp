@@ -0,0 +1,99 @@
+#include "utils/vulkan/descriptor_allocator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace utils::vulkan {
+
+    utils::Logger DescriptorAllocator::log("DescriptorAllocator");
+
+
+    DescriptorPoolConfig DescriptorAllocatorConfig::getPoolConfig() const {
+        DescriptorPoolConfig poolConfig(this->setsPerPool);
+
+        for (auto const& [descriptorType, count] : this->descriptorsPerSet) {
+            auto const poolSize = static_cast<uint32_t>(std::ceil(count * static_cast<float>(this->setsPerPool)));
+            poolConfig.addPool(descriptorType, std::max(poolSize, 1u));
+        }
+
+        return poolConfig;
+    }
+
+
+    DescriptorAllocator::DescriptorAllocator(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        DescriptorAllocatorConfig const& config,
+        uint32_t const frameCount
+    ) :
+        vkDeviceHandle(vkDeviceHandle),
+        config(config),
+        framePools(frameCount)
+    {
+        if (frameCount == 0) {
+            throw std::runtime_error("Descriptor allocator requires at least one frame.");
+        }
+    }
+
+
+    void DescriptorAllocator::addPool() {
+        auto& pools = this->framePools[this->frameIndex];
+
+        if (!this->freePools.empty()) {
+            pools.push_back(this->freePools.back());
+            this->freePools.pop_back();
+            return;
+        }
+
+        INFO(log) << "Descriptor pools exhausted, adding pool " << this->getPoolCount() + 1 << "." << std::endl;
+        pools.push_back(std::make_shared<DescriptorPool>(this->vkDeviceHandle, this->config.getPoolConfig()));
+    }
+
+
+    void DescriptorAllocator::beginFrame(uint32_t const frameIndex) {
+        if (frameIndex >= this->framePools.size()) {
+            throw std::runtime_error("Descriptor allocator frame index out of range.");
+        }
+
+        this->frameIndex = frameIndex;
+        auto& pools = this->framePools[frameIndex];
+
+        for (auto const& pool : pools) {
+            pool->reset();
+            this->freePools.push_back(pool);
+        }
+
+        pools.clear();
+    }
+
+
+    std::shared_ptr<DescriptorSet> DescriptorAllocator::allocate(std::shared_ptr<DescriptorSetLayout> const& layout) {
+        auto& pools = this->framePools[this->frameIndex];
+
+        if (!pools.empty()) {
+            if (auto const descriptorSet = pools.back()->tryAllocateDescriptorSet(layout)) {
+                return descriptorSet;
+            }
+        }
+
+        this->addPool();
+
+        if (auto const descriptorSet = pools.back()->tryAllocateDescriptorSet(layout)) {
+            return descriptorSet;
+        }
+
+        throw std::runtime_error("Failed to allocate descriptor set, layout does not fit in an empty descriptor pool.");
+    }
+
+
+    std::size_t DescriptorAllocator::getPoolCount() const {
+        std::size_t poolCount = this->freePools.size();
+
+        for (auto const& pools : this->framePools) {
+            poolCount += pools.size();
+        }
+
+        return poolCount;
+    }
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "utils/vulkan/handles.hpp"
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/descriptor_pool.hpp"
+#include "utils/vulkan/descriptor_set.hpp"
+#include "utils/vulkan/descriptor_set_layout.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Configuration struct for creating descriptor allocators.
+     */
+    struct DescriptorAllocatorConfig {
+        // Number of descriptor sets each pool can hold
+        uint32_t setsPerPool;
+
+        // Average number of descriptors of each type per set, used to size pools
+        std::vector<std::pair<VkDescriptorType, float>> descriptorsPerSet;
+
+        /**
+         * @brief Add a descriptor type to the pools.
+         * @param descriptorType Type of descriptor.
+         * @param count Average number of descriptors of this type in each allocated set.
+         */
+        void addDescriptorType(VkDescriptorType const descriptorType, float const count) {
+            descriptorsPerSet.push_back({descriptorType, count});
+        }
+
+        /**
+         * @brief Get the config of each pool in the allocator.
+         */
+        DescriptorPoolConfig getPoolConfig() const;
+
+        DescriptorAllocatorConfig(uint32_t const setsPerPool = 64)
+            : setsPerPool(setsPerPool) {}
+    };
+
+
+    /**
+     * @brief Allocates transient descriptor sets which live for a single frame in flight.
+     * Each frame allocates from its own chain of pools, adding another pool when the current one is
+     * exhausted. Sets are never freed individually, instead the whole chain is reset when the frame
+     * comes around again, and its pools are reused. Exhaustion is detected through allocation
+     * failing, so the device must enable VK_KHR_maintenance1. Not thread safe.
+     */
+    class DescriptorAllocator {
+    private:
+        static utils::Logger log;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+        DescriptorAllocatorConfig const config;
+
+        // Pools allocated from by each frame, the last one is the current pool
+        std::vector<std::vector<std::shared_ptr<DescriptorPool>>> framePools;
+
+        // Reset pools, ready to be picked up by any frame
+        std::vector<std::shared_ptr<DescriptorPool>> freePools;
+
+        uint32_t frameIndex = 0;
+
+    private:
+        void addPool();
+
+    public:
+        DescriptorAllocator(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            DescriptorAllocatorConfig const& config,
+            uint32_t const frameCount);
+
+        /**
+         * @brief Start allocating for a frame, freeing every set the frame allocated last time around.
+         * @param frameIndex Index of the frame in flight, sets it allocated previously must no longer be in use.
+         */
+        void beginFrame(uint32_t const frameIndex);
+
+        /**
+         * @brief Allocate a descriptor set for the current frame.
+         * The set is valid until beginFrame is next called with the same frame index.
+         * @param layout Layout of the descriptor set.
+         * @return Shared pointer to newly allocated descriptor set.
+         */
+        std::shared_ptr<DescriptorSet> allocate(std::shared_ptr<DescriptorSetLayout> const& layout);
+
+        /**
+         * @brief Get the total number of pools created, for diagnostics.
+         */
+        std::size_t getPoolCount() const;
+    };
+
+}
@@ -17,7 +17,7 @@ namespace utils::vulkan {
 
         VkDescriptorPoolCreateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        createInfo.flags = 0;
+        createInfo.flags = config.flags;
         createInfo.maxSets = config.maxSets;
         createInfo.poolSizeCount = static_cast<uint32_t>(config.poolSizes.size());
         createInfo.pPoolSizes = config.poolSizes.data();
@@ -32,4 +32,57 @@ namespace utils::vulkan {
         return std::make_shared<DescriptorSet>(this->vkDeviceHandle, this->vkHandle, layout->getHandle());
     }
 
+
+    std::shared_ptr<DescriptorSet> DescriptorPool::allocateDescriptorSet(
+        std::shared_ptr<DescriptorSetLayout> const& layout,
+        uint32_t const variableDescriptorCount
+    ) {
+        VkDescriptorSetVariableDescriptorCountAllocateInfoEXT variableCountInfo {};
+        variableCountInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT;
+        variableCountInfo.descriptorSetCount = 1;
+        variableCountInfo.pDescriptorCounts = &variableDescriptorCount;
+
+        VkDescriptorSetAllocateInfo allocateInfo {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.pNext = &variableCountInfo;
+        allocateInfo.descriptorPool = this->vkHandle->vk;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &layout->getHandle()->vk;
+
+        VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+
+        if (vkAllocateDescriptorSets(this->vkDeviceHandle->vk, &allocateInfo, &vkDescriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate variable count descriptor set.");
+        }
+
+        return std::make_shared<DescriptorSet>(this->vkDeviceHandle, this->vkHandle, layout->getHandle(), vkDescriptorSet);
+    }
+
+
+    std::shared_ptr<DescriptorSet> DescriptorPool::tryAllocateDescriptorSet(std::shared_ptr<DescriptorSetLayout> const& layout) {
+        VkDescriptorSetAllocateInfo allocateInfo {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorPool = this->vkHandle->vk;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &layout->getHandle()->vk;
+
+        VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+        VkResult const result = vkAllocateDescriptorSets(this->vkDeviceHandle->vk, &allocateInfo, &vkDescriptorSet);
+
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+            return nullptr;
+        } else if (result != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate descriptor set.");
+        }
+
+        return std::make_shared<DescriptorSet>(this->vkDeviceHandle, this->vkHandle, layout->getHandle(), vkDescriptorSet);
+    }
+
+
+    void DescriptorPool::reset() {
+        if (vkResetDescriptorPool(this->vkDeviceHandle->vk, this->vkHandle->vk, 0) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to reset descriptor pool.");
+        }
+    }
+
 }
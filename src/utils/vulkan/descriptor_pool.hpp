@@ -15,6 +15,7 @@ namespace utils::vulkan {
      */
     struct DescriptorPoolConfig {
         uint32_t const maxSets;
+        VkDescriptorPoolCreateFlags flags = 0;
         std::vector<VkDescriptorPoolSize> poolSizes;
 
         /**
@@ -51,6 +52,31 @@ namespace utils::vulkan {
          * @return Shared pointer to newly allocated descriptor set.
          */
         std::shared_ptr<DescriptorSet> allocateDescriptorSet(std::shared_ptr<DescriptorSetLayout> const& layout);
+
+        /**
+         * @brief Allocate a descriptor set whose last binding has a variable descriptor count.
+         * @param layout Layout of the descriptor set, the last binding must have VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT.
+         * @param variableDescriptorCount Number of descriptors in the last binding.
+         * @return Shared pointer to newly allocated descriptor set.
+         */
+        std::shared_ptr<DescriptorSet> allocateDescriptorSet(
+            std::shared_ptr<DescriptorSetLayout> const& layout,
+            uint32_t const variableDescriptorCount);
+
+        /**
+         * @brief Allocate a descriptor set, without throwing if the pool is exhausted.
+         * Requires VK_KHR_maintenance1 (core in Vulkan 1.1), without it allocating
+         * from an exhausted pool is invalid usage rather than an error.
+         * @param layout Layout of the descriptor set.
+         * @return Shared pointer to newly allocated descriptor set, nullptr if the pool is out of space.
+         */
+        std::shared_ptr<DescriptorSet> tryAllocateDescriptorSet(std::shared_ptr<DescriptorSetLayout> const& layout);
+
+        /**
+         * @brief Return every descriptor set allocated from the pool to it at once.
+         * Sets allocated from the pool must no longer be in use, and must not be used afterwards.
+         */
+        void reset();
     };
 
 }
@@ -1,8 +1,137 @@
 #include "utils/vulkan/descriptor_set.hpp"
+#include "utils/vulkan/descriptor_writer.hpp"
+#include "utils/misc/hash.hpp"
 
 
 namespace utils::vulkan {
 
+    DescriptorSetBindings& DescriptorSetBindings::addBuffer(
+        uint32_t const binding,
+        std::shared_ptr<Buffer> const& buffer,
+        VkDescriptorType const descriptorType,
+        uint64_t const offset,
+        uint64_t const range,
+        uint32_t const arrayElement
+    ) {
+        if (DescriptorWriter::isDynamicBufferType(descriptorType) && range == VK_WHOLE_SIZE) {
+            throw std::runtime_error("Unable to bind buffer, dynamic buffer descriptors require an explicit range.");
+        }
+
+        this->buffers.push_back({binding, arrayElement, descriptorType, buffer->getHandle(), offset, range});
+        return *this;
+    }
+
+
+    DescriptorSetBindings& DescriptorSetBindings::addImage(
+        uint32_t const binding,
+        std::shared_ptr<ImageView> const& imageView,
+        VkDescriptorType const descriptorType,
+        VkImageLayout const imageLayout,
+        uint32_t const arrayElement
+    ) {
+        if (
+            descriptorType != VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE &&
+            descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_IMAGE &&
+            descriptorType != VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT
+        ) {
+            throw std::runtime_error("Unable to bind image, descriptor type is not an image type.");
+        }
+
+        this->images.push_back({binding, arrayElement, descriptorType, imageView->getHandle(), imageLayout, VK_NULL_HANDLE});
+        return *this;
+    }
+
+
+    DescriptorSetBindings& DescriptorSetBindings::addCombinedImageSampler(
+        uint32_t const binding,
+        VkSampler const sampler,
+        std::shared_ptr<ImageView> const& imageView,
+        VkImageLayout const imageLayout,
+        uint32_t const arrayElement
+    ) {
+        this->images.push_back({
+            binding, arrayElement, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageView->getHandle(), imageLayout, sampler});
+        return *this;
+    }
+
+
+    DescriptorSetBindings& DescriptorSetBindings::addSampler(
+        uint32_t const binding,
+        VkSampler const sampler,
+        uint32_t const arrayElement
+    ) {
+        this->images.push_back({
+            binding, arrayElement, VK_DESCRIPTOR_TYPE_SAMPLER, nullptr, VK_IMAGE_LAYOUT_UNDEFINED, sampler});
+        return *this;
+    }
+
+
+    bool DescriptorSetBindings::operator==(DescriptorSetBindings const& other) const {
+        if (this->buffers.size() != other.buffers.size() || this->images.size() != other.images.size()) {
+            return false;
+        }
+
+        for (unsigned i = 0; i < this->buffers.size(); i++) {
+            auto const& a = this->buffers[i];
+            auto const& b = other.buffers[i];
+
+            if (
+                a.binding != b.binding ||
+                a.arrayElement != b.arrayElement ||
+                a.descriptorType != b.descriptorType ||
+                a.buffer != b.buffer ||
+                a.offset != b.offset ||
+                a.range != b.range
+            ) {
+                return false;
+            }
+        }
+
+        for (unsigned i = 0; i < this->images.size(); i++) {
+            auto const& a = this->images[i];
+            auto const& b = other.images[i];
+
+            if (
+                a.binding != b.binding ||
+                a.arrayElement != b.arrayElement ||
+                a.descriptorType != b.descriptorType ||
+                a.imageView != b.imageView ||
+                a.imageLayout != b.imageLayout ||
+                a.sampler != b.sampler
+            ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    std::size_t DescriptorSetBindings::hash() const {
+        std::size_t seed = 0;
+
+        for (auto const& buffer : this->buffers) {
+            utils::hashCombine(seed, buffer.binding);
+            utils::hashCombine(seed, buffer.arrayElement);
+            utils::hashCombine(seed, buffer.descriptorType);
+            utils::hashCombine(seed, buffer.buffer.get());
+            utils::hashCombine(seed, buffer.offset);
+            utils::hashCombine(seed, buffer.range);
+        }
+
+        for (auto const& image : this->images) {
+            utils::hashCombine(seed, image.binding);
+            utils::hashCombine(seed, image.arrayElement);
+            utils::hashCombine(seed, image.descriptorType);
+            utils::hashCombine(seed, image.imageView.get());
+            utils::hashCombine(seed, image.imageLayout);
+            utils::hashCombine(seed, image.sampler);
+        }
+
+        return seed;
+    }
+
+
     utils::Logger DescriptorSet::log("DescriptorSet");
 
 
@@ -29,18 +158,40 @@ namespace utils::vulkan {
     }
 
 
-    void DescriptorSet::update(uint32_t const binding, std::shared_ptr<Buffer> const& buffer) {
+    DescriptorSet::DescriptorSet(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        std::shared_ptr<DescriptorPoolHandle> const& vkDescriptorPoolHandle,
+        std::shared_ptr<DescriptorSetLayoutHandle> const& vkDescriptorSetLayoutHandle,
+        VkDescriptorSet_T * const vk
+    ) :
+        vkDeviceHandle(vkDeviceHandle),
+        vkDescriptorPoolHandle(vkDescriptorPoolHandle),
+        vkDescriptorSetLayoutHandle(vkDescriptorSetLayoutHandle),
+        vk(vk) {}
+
+
+    void DescriptorSet::update(
+        uint32_t const binding,
+        std::shared_ptr<Buffer> const& buffer,
+        VkDescriptorType const descriptorType,
+        uint64_t const offset,
+        uint64_t const range
+    ) {
+        if (DescriptorWriter::isDynamicBufferType(descriptorType) && range == VK_WHOLE_SIZE) {
+            throw std::runtime_error("Unable to update descriptor set, dynamic buffer descriptors require an explicit range.");
+        }
+
         VkDescriptorBufferInfo bufferInfo {};
         bufferInfo.buffer = buffer->getHandle()->vk;
-        bufferInfo.offset = 0;
-        bufferInfo.range = VK_WHOLE_SIZE;
+        bufferInfo.offset = offset;
+        bufferInfo.range = range;
 
         VkWriteDescriptorSet descriptorWrite {};
         descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrite.dstSet = this->vk;
         descriptorWrite.dstBinding = binding;
         descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrite.descriptorType = descriptorType;
         descriptorWrite.descriptorCount = 1;
         descriptorWrite.pBufferInfo = &bufferInfo;
 
@@ -3,10 +3,115 @@
 #include "utils/vulkan/handles.hpp"
 #include "utils/misc/logging.hpp"
 #include "utils/vulkan/buffer.hpp"
+#include "utils/vulkan/image_view.hpp"
+
+#include <vector>
 
 
 namespace utils::vulkan {
 
+    /**
+     * @brief The resources bound to a descriptor set, which together identify its contents.
+     * Resources are compared by handle, so two sets of bindings are equal when they refer to the
+     * same buffers, image views and samplers with the same parameters, in the same order.
+     */
+    struct DescriptorSetBindings {
+        struct BufferBinding {
+            uint32_t binding;
+            uint32_t arrayElement;
+            VkDescriptorType descriptorType;
+            std::shared_ptr<BufferHandle> buffer;
+            uint64_t offset;
+            uint64_t range;
+        };
+
+        struct ImageBinding {
+            uint32_t binding;
+            uint32_t arrayElement;
+            VkDescriptorType descriptorType;
+            std::shared_ptr<ImageViewHandle> imageView; // nullptr for VK_DESCRIPTOR_TYPE_SAMPLER
+            VkImageLayout imageLayout;
+            VkSampler sampler; // VK_NULL_HANDLE unless the descriptor type uses a sampler
+        };
+
+        std::vector<BufferBinding> buffers;
+        std::vector<ImageBinding> images;
+
+        /**
+         * @brief Bind a range of a buffer.
+         * @param binding The index of the binding.
+         * @param buffer The buffer to bind.
+         * @param descriptorType Type of the descriptor (e.g. VK_DESCRIPTOR_TYPE_STORAGE_BUFFER).
+         * @param offset Offset of the bound range within the buffer in bytes.
+         * @param range Size of the bound range in bytes, dynamic descriptor types require an explicit range.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorSetBindings& addBuffer(
+            uint32_t const binding,
+            std::shared_ptr<Buffer> const& buffer,
+            VkDescriptorType const descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            uint64_t const offset = 0,
+            uint64_t const range = VK_WHOLE_SIZE,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Bind an image view which is used without a sampler.
+         * @param binding The index of the binding.
+         * @param imageView The image view to bind.
+         * @param descriptorType Either VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE or VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT.
+         * @param imageLayout Layout the image will be in when accessed through the descriptor.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorSetBindings& addImage(
+            uint32_t const binding,
+            std::shared_ptr<ImageView> const& imageView,
+            VkDescriptorType const descriptorType,
+            VkImageLayout const imageLayout,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Bind an image view together with a sampler.
+         * @param binding The index of the binding.
+         * @param sampler The sampler to bind.
+         * @param imageView The image view to bind.
+         * @param imageLayout Layout the image will be in when accessed through the descriptor.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorSetBindings& addCombinedImageSampler(
+            uint32_t const binding,
+            VkSampler const sampler,
+            std::shared_ptr<ImageView> const& imageView,
+            VkImageLayout const imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Bind a sampler.
+         * @param binding The index of the binding.
+         * @param sampler The sampler to bind.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorSetBindings& addSampler(
+            uint32_t const binding,
+            VkSampler const sampler,
+            uint32_t const arrayElement = 0);
+
+        bool operator==(DescriptorSetBindings const& other) const;
+
+        bool operator!=(DescriptorSetBindings const& other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Hash the bound resources.
+         */
+        std::size_t hash() const;
+    };
+
+
     class DescriptorSet {
     private:
         static utils::Logger log;
@@ -24,12 +129,33 @@ namespace utils::vulkan {
             std::shared_ptr<DescriptorPoolHandle> const& vkDescriptorPoolHandle,
             std::shared_ptr<DescriptorSetLayoutHandle> const& vkDescriptorSetLayoutHandle);
 
+        /**
+         * @brief Wrap a descriptor set which has already been allocated from a pool.
+         * @param vk The allocated descriptor set.
+         */
+        DescriptorSet(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            std::shared_ptr<DescriptorPoolHandle> const& vkDescriptorPoolHandle,
+            std::shared_ptr<DescriptorSetLayoutHandle> const& vkDescriptorSetLayoutHandle,
+            VkDescriptorSet_T * const vk);
+
         /**
          * @brief Update a descriptor set with data.
+         * Writes a single descriptor without allocating, use a DescriptorWriter to batch several writes.
+         * Dynamic descriptor types require an explicit range, the dynamic offset passed at bind
+         * time is added to the offset given here.
          * @param binding The index of the binding to update.
          * @param buffer A buffer to update the specified descriptor with.
+         * @param descriptorType Type of the descriptor (e.g. VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC).
+         * @param offset Offset of the bound range within the buffer in bytes.
+         * @param range Size of the bound range in bytes.
          */
-        void update(uint32_t const binding, std::shared_ptr<Buffer> const& buffer);
+        void update(
+            uint32_t const binding,
+            std::shared_ptr<Buffer> const& buffer,
+            VkDescriptorType const descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            uint64_t const offset = 0,
+            uint64_t const range = VK_WHOLE_SIZE);
     };
 
 }
@@ -0,0 +1,149 @@
+#include "utils/vulkan/descriptor_set_cache.hpp"
+#include "utils/misc/hash.hpp"
+
+
+namespace utils::vulkan {
+
+    utils::Logger DescriptorSetCache::log("DescriptorSetCache");
+
+
+    bool DescriptorSetCache::ResourceKey::operator==(ResourceKey const& other) const {
+        return
+            this->binding == other.binding &&
+            this->arrayElement == other.arrayElement &&
+            this->descriptorType == other.descriptorType &&
+            this->resource == other.resource &&
+            this->offset == other.offset &&
+            this->range == other.range &&
+            this->imageLayout == other.imageLayout &&
+            this->sampler == other.sampler;
+    }
+
+
+    std::size_t DescriptorSetCache::KeyHash::operator()(Key const& key) const {
+        std::size_t seed = 0;
+        utils::hashCombine(seed, key.layout);
+
+        for (auto const& resource : key.resources) {
+            utils::hashCombine(seed, resource.binding);
+            utils::hashCombine(seed, resource.arrayElement);
+            utils::hashCombine(seed, resource.descriptorType);
+            utils::hashCombine(seed, resource.resource);
+            utils::hashCombine(seed, resource.offset);
+            utils::hashCombine(seed, resource.range);
+            utils::hashCombine(seed, resource.imageLayout);
+            utils::hashCombine(seed, resource.sampler);
+        }
+
+        return seed;
+    }
+
+
+    bool DescriptorSetCache::Entry::isExpired() const {
+        for (auto const& resource : this->resources) {
+            if (resource.expired()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
+    DescriptorSetCache::Key DescriptorSetCache::createKey(
+        std::shared_ptr<DescriptorSetLayout> const& layout,
+        DescriptorSetBindings const& bindings,
+        std::vector<std::weak_ptr<void const>>& resources
+    ) {
+        Key key {layout->getHandle().get(), {}};
+        key.resources.reserve(bindings.buffers.size() + bindings.images.size());
+
+        for (auto const& buffer : bindings.buffers) {
+            key.resources.push_back({
+                buffer.binding, buffer.arrayElement, buffer.descriptorType, buffer.buffer.get(),
+                buffer.offset, buffer.range, VK_IMAGE_LAYOUT_UNDEFINED, VK_NULL_HANDLE});
+            resources.push_back(buffer.buffer);
+        }
+
+        for (auto const& image : bindings.images) {
+            key.resources.push_back({
+                image.binding, image.arrayElement, image.descriptorType, image.imageView.get(),
+                0, 0, image.imageLayout, image.sampler});
+
+            if (image.imageView) {
+                resources.push_back(image.imageView);
+            }
+        }
+
+        return key;
+    }
+
+
+    DescriptorSetCache::DescriptorSetCache(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        DescriptorAllocatorConfig const& config
+    ) :
+        vkDeviceHandle(vkDeviceHandle),
+        config(config),
+        allocator(std::make_unique<DescriptorAllocator>(vkDeviceHandle, config, 1)),
+        writer(vkDeviceHandle) {}
+
+
+    std::shared_ptr<DescriptorSet> DescriptorSetCache::get(
+        std::shared_ptr<DescriptorSetLayout> const& layout,
+        DescriptorSetBindings const& bindings
+    ) {
+        std::vector<std::weak_ptr<void const>> resources;
+        Key key = createKey(layout, bindings, resources);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto const existing = this->descriptorSets.find(key);
+
+        if (existing != this->descriptorSets.end()) {
+            // A destroyed resource's handle address may have been reused by a new resource
+            if (!existing->second.isExpired()) {
+                return existing->second.descriptorSet;
+            }
+
+            this->descriptorSets.erase(existing);
+        }
+
+        auto const descriptorSet = this->allocator->allocate(layout);
+        this->writer.writeBindings(*descriptorSet, bindings).flush();
+        this->descriptorSets.emplace(std::move(key), Entry {descriptorSet, std::move(resources)});
+
+        INFO(log) << "Cached descriptor set " << this->descriptorSets.size() << std::endl;
+        return descriptorSet;
+    }
+
+
+    std::size_t DescriptorSetCache::size() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->descriptorSets.size();
+    }
+
+
+    std::size_t DescriptorSetCache::prune() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::size_t pruned = 0;
+
+        for (auto it = this->descriptorSets.begin(); it != this->descriptorSets.end();) {
+            if (it->second.isExpired()) {
+                it = this->descriptorSets.erase(it);
+                pruned++;
+            } else {
+                it++;
+            }
+        }
+
+        return pruned;
+    }
+
+
+    void DescriptorSetCache::clear() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->descriptorSets.clear();
+        this->allocator = std::make_unique<DescriptorAllocator>(this->vkDeviceHandle, this->config, 1);
+    }
+
+}
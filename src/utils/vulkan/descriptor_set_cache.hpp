@@ -0,0 +1,126 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/descriptor_allocator.hpp"
+#include "utils/vulkan/descriptor_set.hpp"
+#include "utils/vulkan/descriptor_set_layout.hpp"
+#include "utils/vulkan/descriptor_writer.hpp"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Shares descriptor sets with identical layouts and bound resources.
+     * Draws with the same material bindings get the same set, which is only written once, so it
+     * can be reused across draws and frames. Intended for long-lived material resources only,
+     * per-frame or transient bindings belong in a DescriptorAllocator.
+     * The cache doesn't keep bound resources alive. Entries whose resources have been destroyed
+     * are replaced when looked up again, or dropped by prune(). Their descriptor memory is only
+     * returned to the device by clear().
+     */
+    class DescriptorSetCache {
+    private:
+        static utils::Logger log;
+
+        // A bound resource, identified by the address of its handle so the key doesn't own it
+        struct ResourceKey {
+            uint32_t binding;
+            uint32_t arrayElement;
+            VkDescriptorType descriptorType;
+            void const* resource;
+            uint64_t offset;
+            uint64_t range;
+            VkImageLayout imageLayout;
+            VkSampler sampler;
+
+            bool operator==(ResourceKey const& other) const;
+        };
+
+        struct Key {
+            DescriptorSetLayoutHandle const* layout;
+            std::vector<ResourceKey> resources;
+
+            bool operator==(Key const& other) const {
+                return this->layout == other.layout && this->resources == other.resources;
+            }
+        };
+
+        struct KeyHash {
+            std::size_t operator()(Key const& key) const;
+        };
+
+        struct Entry {
+            std::shared_ptr<DescriptorSet> descriptorSet;
+
+            // Bound resources, the entry is stale once any of them has been destroyed
+            std::vector<std::weak_ptr<void const>> resources;
+
+            bool isExpired() const;
+        };
+
+        mutable std::mutex mutex;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+        DescriptorAllocatorConfig const config;
+
+        // Sets live until the cache is cleared, so they come from a single frame which is never retired.
+        // Clearing replaces the allocator rather than resetting it, sets keep their pool alive.
+        std::unique_ptr<DescriptorAllocator> allocator;
+
+        // Reused for every new set, so writing one doesn't allocate once the writer has grown to size
+        DescriptorWriter writer;
+
+        std::unordered_map<Key, Entry, KeyHash> descriptorSets;
+
+        /**
+         * @brief Build the non-owning key and the resource references of a set of bindings.
+         */
+        static Key createKey(
+            std::shared_ptr<DescriptorSetLayout> const& layout,
+            DescriptorSetBindings const& bindings,
+            std::vector<std::weak_ptr<void const>>& resources);
+
+    public:
+        /**
+         * @param config Descriptor pool sizing, pools are added as the cache grows.
+         */
+        DescriptorSetCache(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            DescriptorAllocatorConfig const& config);
+
+        /**
+         * @brief Get a descriptor set with the given resources bound, allocating and writing it if none exists.
+         * @param layout Layout of the descriptor set.
+         * @param bindings Resources to bind to the set.
+         * @return Shared pointer to descriptor set object.
+         */
+        std::shared_ptr<DescriptorSet> get(
+            std::shared_ptr<DescriptorSetLayout> const& layout,
+            DescriptorSetBindings const& bindings);
+
+        /**
+         * @brief Get the number of cached descriptor sets.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Drop cached sets which refer to destroyed resources.
+         * @return Number of sets dropped.
+         */
+        std::size_t prune();
+
+        /**
+         * @brief Drop all cached descriptor sets, and release their resources.
+         * Sets still referenced elsewhere remain valid, the pools they were allocated from are
+         * destroyed once the last of their sets is released. Later sets come from new pools.
+         */
+        void clear();
+    };
+
+}
@@ -1,8 +1,58 @@
 #include "utils/vulkan/descriptor_set_layout.hpp"
+#include "utils/misc/hash.hpp"
+
+#include <algorithm>
 
 
 namespace utils::vulkan {
 
+    bool DescriptorSetLayoutConfig::operator==(DescriptorSetLayoutConfig const& other) const {
+        if (
+            this->flags != other.flags ||
+            this->bindingFlags != other.bindingFlags ||
+            this->descriptorBindings.size() != other.descriptorBindings.size()
+        ) {
+            return false;
+        }
+
+        for (unsigned i = 0; i < this->descriptorBindings.size(); i++) {
+            auto const& a = this->descriptorBindings[i];
+            auto const& b = other.descriptorBindings[i];
+
+            if (
+                a.binding != b.binding ||
+                a.descriptorType != b.descriptorType ||
+                a.descriptorCount != b.descriptorCount ||
+                a.stageFlags != b.stageFlags ||
+                a.pImmutableSamplers != b.pImmutableSamplers
+            ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    std::size_t DescriptorSetLayoutConfig::hash() const {
+        std::size_t seed = 0;
+        utils::hashCombine(seed, this->flags);
+
+        for (auto const& flags : this->bindingFlags) {
+            utils::hashCombine(seed, flags);
+        }
+
+        for (auto const& binding : this->descriptorBindings) {
+            utils::hashCombine(seed, binding.binding);
+            utils::hashCombine(seed, static_cast<uint32_t>(binding.descriptorType));
+            utils::hashCombine(seed, binding.descriptorCount);
+            utils::hashCombine(seed, binding.stageFlags);
+        }
+
+        return seed;
+    }
+
+
     DescriptorSetLayout::DescriptorSetLayout(
         std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
         DescriptorSetLayoutConfig const& config
@@ -12,9 +62,28 @@ namespace utils::vulkan {
     {
         VkDescriptorSetLayoutCreateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        createInfo.flags = config.flags;
         createInfo.bindingCount = static_cast<uint32_t>(config.descriptorBindings.size());
         createInfo.pBindings = config.descriptorBindings.data();
 
+        VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo {};
+        bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        bindingFlagsCreateInfo.bindingCount = static_cast<uint32_t>(config.bindingFlags.size());
+        bindingFlagsCreateInfo.pBindingFlags = config.bindingFlags.data();
+
+        bool const hasBindingFlags = std::any_of(
+            config.bindingFlags.begin(),
+            config.bindingFlags.end(),
+            [](VkDescriptorBindingFlagsEXT const flags) { return flags != 0; });
+
+        if (hasBindingFlags) {
+            if (config.bindingFlags.size() != config.descriptorBindings.size()) {
+                throw std::runtime_error("Failed to create descriptor set layout, binding flags must be given for every binding.");
+            }
+
+            createInfo.pNext = &bindingFlagsCreateInfo;
+        }
+
         if (vkCreateDescriptorSetLayout(this->vkDeviceHandle->vk, &createInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create descriptor set layout.");
         }
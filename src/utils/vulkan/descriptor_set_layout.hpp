@@ -14,20 +14,26 @@ namespace utils::vulkan {
      * @brief Config object for initialisation of descriptor set layouts.
      */
     struct DescriptorSetLayoutConfig {
+        VkDescriptorSetLayoutCreateFlags flags = 0;
         std::vector<VkDescriptorSetLayoutBinding> descriptorBindings;
 
+        // One entry per binding, only passed to vulkan if any are set (requires VK_EXT_descriptor_indexing)
+        std::vector<VkDescriptorBindingFlagsEXT> bindingFlags;
+
         /**
          * @brief Add a descriptor to the descriptor set config.
          * @param bindingIndex Index of the binding within the shader.
          * @param descriptorType Type of this descriptor binding.
          * @param stageFlags Stages of the shader pipeline to which the binding is required.
          * @param descriptorCount Number of descriptors to add to the layout.
+         * @param descriptorBindingFlags Descriptor indexing flags (e.g. VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT).
          */
         void addDescriptor(
             uint32_t const bindingIndex,
             VkDescriptorType const descriptorType,
             VkShaderStageFlags const stageFlags,
-            uint32_t const descriptorCount = 1
+            uint32_t const descriptorCount = 1,
+            VkDescriptorBindingFlagsEXT const descriptorBindingFlags = 0
         ) {
             VkDescriptorSetLayoutBinding descriptorBinding {};
             descriptorBinding.binding = bindingIndex;
@@ -37,7 +43,22 @@ namespace utils::vulkan {
             descriptorBinding.pImmutableSamplers = nullptr;
 
             descriptorBindings.push_back(descriptorBinding);
+            bindingFlags.push_back(descriptorBindingFlags);
         }
+
+        /**
+         * @brief Configs are equal if they contain the same bindings in the same order, with the same flags.
+         */
+        bool operator==(DescriptorSetLayoutConfig const& other) const;
+
+        bool operator!=(DescriptorSetLayoutConfig const& other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Hash the binding list.
+         */
+        std::size_t hash() const;
     };
 
 
@@ -0,0 +1,44 @@
+#include "utils/vulkan/descriptor_update_template.hpp"
+
+
+namespace utils::vulkan {
+
+    utils::Logger DescriptorUpdateTemplate::log("DescriptorUpdateTemplate");
+
+
+    DescriptorUpdateTemplate::DescriptorUpdateTemplate(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        std::shared_ptr<DescriptorSetLayout> const& layout,
+        DescriptorUpdateTemplateConfig const& config
+    ) :
+        HandleWrapper<DescriptorUpdateTemplateHandle>(std::make_shared<DescriptorUpdateTemplateHandle>(vkDeviceHandle)),
+        vkDeviceHandle(vkDeviceHandle),
+        vkDescriptorSetLayoutHandle(layout->getHandle())
+    {
+        INFO(log) << "Creating descriptor update template with " << config.entries.size() << " entries." << std::endl;
+
+        auto const createDescriptorUpdateTemplate = this->vkDeviceHandle->functions.vkCreateDescriptorUpdateTemplate;
+
+        if (createDescriptorUpdateTemplate == nullptr) {
+            throw std::runtime_error("Unable to create descriptor update template, VK_KHR_descriptor_update_template is not enabled.");
+        }
+
+        VkDescriptorUpdateTemplateCreateInfoKHR createInfo {};
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+        createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(config.entries.size());
+        createInfo.pDescriptorUpdateEntries = config.entries.data();
+        createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+        createInfo.descriptorSetLayout = this->vkDescriptorSetLayoutHandle->vk;
+
+        if (createDescriptorUpdateTemplate(this->vkDeviceHandle->vk, &createInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create descriptor update template.");
+        }
+    }
+
+
+    void DescriptorUpdateTemplate::update(DescriptorSet const& descriptorSet, void const * const data) const {
+        this->vkDeviceHandle->functions.vkUpdateDescriptorSetWithTemplate(
+            this->vkDeviceHandle->vk, descriptorSet.vk, this->vkHandle->vk, data);
+    }
+
+}
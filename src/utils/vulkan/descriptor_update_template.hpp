@@ -0,0 +1,90 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/descriptor_set.hpp"
+#include "utils/vulkan/descriptor_set_layout.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Configuration struct for creating descriptor update templates.
+     * Each entry says where in a packed struct the descriptor info for a binding lives. Members must
+     * be VkDescriptorBufferInfo for buffers, VkDescriptorImageInfo for images and samplers, and
+     * VkBufferView for texel buffers.
+     */
+    struct DescriptorUpdateTemplateConfig {
+        std::vector<VkDescriptorUpdateTemplateEntryKHR> entries;
+
+        /**
+         * @brief Add an entry to the template.
+         * @param binding The index of the binding to write.
+         * @param descriptorType Type of the descriptors written by this entry.
+         * @param offset Offset of the first descriptor info in the struct, e.g. offsetof(MyStruct, member).
+         * @param descriptorCount Number of consecutive array elements to write.
+         * @param stride Distance between descriptor infos of consecutive array elements in bytes.
+         * @param arrayElement First array element to write.
+         */
+        void addEntry(
+            uint32_t const binding,
+            VkDescriptorType const descriptorType,
+            std::size_t const offset,
+            uint32_t const descriptorCount = 1,
+            std::size_t const stride = 0,
+            uint32_t const arrayElement = 0
+        ) {
+            VkDescriptorUpdateTemplateEntryKHR entry {};
+            entry.dstBinding = binding;
+            entry.dstArrayElement = arrayElement;
+            entry.descriptorCount = descriptorCount;
+            entry.descriptorType = descriptorType;
+            entry.offset = offset;
+            entry.stride = stride;
+
+            entries.push_back(entry);
+        }
+    };
+
+
+    /**
+     * @brief Writes every descriptor of a set from a packed struct in a single call.
+     * Cheaper than vkUpdateDescriptorSets for fixed layouts which are updated often, since the driver
+     * knows the layout of the data up front. Requires VK_KHR_descriptor_update_template.
+     */
+    class DescriptorUpdateTemplate : public HandleWrapper<DescriptorUpdateTemplateHandle> {
+    private:
+        static utils::Logger log;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+        std::shared_ptr<DescriptorSetLayoutHandle> const vkDescriptorSetLayoutHandle;
+
+    public:
+        DescriptorUpdateTemplate(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            std::shared_ptr<DescriptorSetLayout> const& layout,
+            DescriptorUpdateTemplateConfig const& config);
+
+        /**
+         * @brief Write a descriptor set from packed descriptor infos.
+         * @param descriptorSet Descriptor set to write, must have the layout the template was created with.
+         * @param data Pointer to the struct the template entries describe.
+         */
+        void update(DescriptorSet const& descriptorSet, void const * const data) const;
+
+        /**
+         * @brief Write a descriptor set from a packed struct of descriptor infos.
+         * @param descriptorSet Descriptor set to write, must have the layout the template was created with.
+         * @param data Struct the template entries describe.
+         */
+        template<typename T, typename = std::enable_if_t<!std::is_pointer_v<T>>>
+        void update(DescriptorSet const& descriptorSet, T const& data) const {
+            this->update(descriptorSet, static_cast<void const *>(&data));
+        }
+    };
+
+}
@@ -0,0 +1,212 @@
+#include "utils/vulkan/descriptor_writer.hpp"
+
+#include <stdexcept>
+
+
+namespace utils::vulkan {
+
+    DescriptorWriter::DescriptorWriter(std::shared_ptr<DeviceHandle> const& vkDeviceHandle) :
+        vkDeviceHandle(vkDeviceHandle) {}
+
+
+    bool DescriptorWriter::isDynamicBufferType(VkDescriptorType const descriptorType) {
+        return
+            descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+            descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    }
+
+
+    void DescriptorWriter::addWrite(
+        DescriptorSet const& descriptorSet,
+        uint32_t const binding,
+        uint32_t const arrayElement,
+        VkDescriptorType const descriptorType,
+        std::size_t const infoIndex
+    ) {
+        VkWriteDescriptorSet descriptorWrite {};
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.dstSet = descriptorSet.vk;
+        descriptorWrite.dstBinding = binding;
+        descriptorWrite.dstArrayElement = arrayElement;
+        descriptorWrite.descriptorType = descriptorType;
+        descriptorWrite.descriptorCount = 1;
+
+        this->writes.push_back(descriptorWrite);
+        this->infoIndices.push_back(infoIndex);
+    }
+
+
+    DescriptorWriter& DescriptorWriter::writeBuffer(
+        DescriptorSet const& descriptorSet,
+        uint32_t const binding,
+        std::shared_ptr<Buffer> const& buffer,
+        VkDescriptorType const descriptorType,
+        uint64_t const offset,
+        uint64_t const range,
+        uint32_t const arrayElement
+    ) {
+        if (isDynamicBufferType(descriptorType) && range == VK_WHOLE_SIZE) {
+            throw std::runtime_error("Unable to write descriptor, dynamic buffer descriptors require an explicit range.");
+        }
+
+        VkDescriptorBufferInfo bufferInfo {};
+        bufferInfo.buffer = buffer->getHandle()->vk;
+        bufferInfo.offset = offset;
+        bufferInfo.range = range;
+
+        this->addWrite(descriptorSet, binding, arrayElement, descriptorType, this->bufferInfos.size());
+        this->bufferInfos.push_back(bufferInfo);
+        return *this;
+    }
+
+
+    DescriptorWriter& DescriptorWriter::writeImageInfo(
+        DescriptorSet const& descriptorSet,
+        uint32_t const binding,
+        VkDescriptorType const descriptorType,
+        VkSampler const sampler,
+        VkImageView const imageView,
+        VkImageLayout const imageLayout,
+        uint32_t const arrayElement
+    ) {
+        VkDescriptorImageInfo imageInfo {};
+        imageInfo.sampler = sampler;
+        imageInfo.imageView = imageView;
+        imageInfo.imageLayout = imageLayout;
+
+        this->addWrite(descriptorSet, binding, arrayElement, descriptorType, this->imageInfos.size());
+        this->imageInfos.push_back(imageInfo);
+        return *this;
+    }
+
+
+    DescriptorWriter& DescriptorWriter::writeImage(
+        DescriptorSet const& descriptorSet,
+        uint32_t const binding,
+        std::shared_ptr<ImageView> const& imageView,
+        VkDescriptorType const descriptorType,
+        VkImageLayout const imageLayout,
+        uint32_t const arrayElement
+    ) {
+        if (
+            descriptorType != VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE &&
+            descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_IMAGE &&
+            descriptorType != VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT
+        ) {
+            throw std::runtime_error("Unable to write descriptor, descriptor type is not an image type.");
+        }
+
+        return this->writeImageInfo(
+            descriptorSet, binding, descriptorType, VK_NULL_HANDLE, imageView->getHandle()->vk, imageLayout, arrayElement);
+    }
+
+
+    DescriptorWriter& DescriptorWriter::writeCombinedImageSampler(
+        DescriptorSet const& descriptorSet,
+        uint32_t const binding,
+        VkSampler const sampler,
+        std::shared_ptr<ImageView> const& imageView,
+        VkImageLayout const imageLayout,
+        uint32_t const arrayElement
+    ) {
+        return this->writeImageInfo(
+            descriptorSet, binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            sampler, imageView->getHandle()->vk, imageLayout, arrayElement);
+    }
+
+
+    DescriptorWriter& DescriptorWriter::writeSampler(
+        DescriptorSet const& descriptorSet,
+        uint32_t const binding,
+        VkSampler const sampler,
+        uint32_t const arrayElement
+    ) {
+        return this->writeImageInfo(
+            descriptorSet, binding, VK_DESCRIPTOR_TYPE_SAMPLER,
+            sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED, arrayElement);
+    }
+
+
+    DescriptorWriter& DescriptorWriter::writeTexelBuffer(
+        DescriptorSet const& descriptorSet,
+        uint32_t const binding,
+        VkBufferView const bufferView,
+        VkDescriptorType const descriptorType,
+        uint32_t const arrayElement
+    ) {
+        if (descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER && descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER) {
+            throw std::runtime_error("Unable to write descriptor, descriptor type is not a texel buffer type.");
+        }
+
+        this->addWrite(descriptorSet, binding, arrayElement, descriptorType, this->texelBufferViews.size());
+        this->texelBufferViews.push_back(bufferView);
+        return *this;
+    }
+
+
+    DescriptorWriter& DescriptorWriter::writeBindings(DescriptorSet const& descriptorSet, DescriptorSetBindings const& bindings) {
+        for (auto const& buffer : bindings.buffers) {
+            VkDescriptorBufferInfo bufferInfo {};
+            bufferInfo.buffer = buffer.buffer->vk;
+            bufferInfo.offset = buffer.offset;
+            bufferInfo.range = buffer.range;
+
+            this->addWrite(descriptorSet, buffer.binding, buffer.arrayElement, buffer.descriptorType, this->bufferInfos.size());
+            this->bufferInfos.push_back(bufferInfo);
+        }
+
+        for (auto const& image : bindings.images) {
+            this->writeImageInfo(
+                descriptorSet, image.binding, image.descriptorType,
+                image.sampler, image.imageView ? image.imageView->vk : VK_NULL_HANDLE, image.imageLayout, image.arrayElement);
+        }
+
+        return *this;
+    }
+
+
+    void DescriptorWriter::flush() {
+        if (this->writes.empty()) {
+            return;
+        }
+
+        for (unsigned i = 0; i < this->writes.size(); i++) {
+            auto& descriptorWrite = this->writes[i];
+            auto const infoIndex = this->infoIndices[i];
+
+            switch (descriptorWrite.descriptorType) {
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                    descriptorWrite.pBufferInfo = &this->bufferInfos[infoIndex];
+                    break;
+                case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+                case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                    descriptorWrite.pTexelBufferView = &this->texelBufferViews[infoIndex];
+                    break;
+                default:
+                    descriptorWrite.pImageInfo = &this->imageInfos[infoIndex];
+                    break;
+            }
+        }
+
+        vkUpdateDescriptorSets(
+            this->vkDeviceHandle->vk,
+            static_cast<uint32_t>(this->writes.size()),
+            this->writes.data(),
+            0, nullptr);
+
+        this->clear();
+    }
+
+
+    void DescriptorWriter::clear() {
+        this->writes.clear();
+        this->infoIndices.clear();
+        this->bufferInfos.clear();
+        this->imageInfos.clear();
+        this->texelBufferViews.clear();
+    }
+
+}
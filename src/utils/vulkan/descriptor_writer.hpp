@@ -0,0 +1,170 @@
+#pragma once
+
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/buffer.hpp"
+#include "utils/vulkan/image_view.hpp"
+#include "utils/vulkan/descriptor_set.hpp"
+
+#include <memory>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Collects descriptor writes to any number of sets, and applies them with a single vkUpdateDescriptorSets call.
+     * Storage is kept between flushes, so a reused writer stops allocating once it has grown to size.
+     * Only raw handles are recorded, resources must stay alive until the writes are flushed.
+     */
+    class DescriptorWriter {
+    private:
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+        std::vector<VkWriteDescriptorSet> writes;
+
+        // Position of each write's info in the array for its descriptor type. The arrays may
+        // reallocate as writes are added, so info pointers are only filled in when flushing.
+        std::vector<std::size_t> infoIndices;
+
+        std::vector<VkDescriptorBufferInfo> bufferInfos;
+        std::vector<VkDescriptorImageInfo> imageInfos;
+        std::vector<VkBufferView> texelBufferViews;
+
+    private:
+        void addWrite(
+            DescriptorSet const& descriptorSet,
+            uint32_t const binding,
+            uint32_t const arrayElement,
+            VkDescriptorType const descriptorType,
+            std::size_t const infoIndex);
+
+        DescriptorWriter& writeImageInfo(
+            DescriptorSet const& descriptorSet,
+            uint32_t const binding,
+            VkDescriptorType const descriptorType,
+            VkSampler const sampler,
+            VkImageView const imageView,
+            VkImageLayout const imageLayout,
+            uint32_t const arrayElement);
+
+    public:
+        DescriptorWriter(std::shared_ptr<DeviceHandle> const& vkDeviceHandle);
+
+        /**
+         * @brief Check whether a descriptor type takes a dynamic offset when bound.
+         */
+        static bool isDynamicBufferType(VkDescriptorType const descriptorType);
+
+        /**
+         * @brief Write a buffer descriptor.
+         * @param descriptorSet The descriptor set to write to.
+         * @param binding The index of the binding to write.
+         * @param buffer The buffer to bind.
+         * @param descriptorType Uniform or storage buffer type, dynamic or not.
+         * @param offset Offset of the bound range within the buffer in bytes.
+         * @param range Size of the bound range in bytes, dynamic descriptor types require an explicit range.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorWriter& writeBuffer(
+            DescriptorSet const& descriptorSet,
+            uint32_t const binding,
+            std::shared_ptr<Buffer> const& buffer,
+            VkDescriptorType const descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            uint64_t const offset = 0,
+            uint64_t const range = VK_WHOLE_SIZE,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Write an image descriptor which is used without a sampler.
+         * @param descriptorSet The descriptor set to write to.
+         * @param binding The index of the binding to write.
+         * @param imageView The image view to bind.
+         * @param descriptorType Either VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE or VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT.
+         * @param imageLayout Layout the image will be in when accessed through the descriptor.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorWriter& writeImage(
+            DescriptorSet const& descriptorSet,
+            uint32_t const binding,
+            std::shared_ptr<ImageView> const& imageView,
+            VkDescriptorType const descriptorType,
+            VkImageLayout const imageLayout,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Write a combined image sampler descriptor.
+         * @param descriptorSet The descriptor set to write to.
+         * @param binding The index of the binding to write.
+         * @param sampler The sampler to bind, ignored if the binding uses immutable samplers.
+         * @param imageView The image view to bind.
+         * @param imageLayout Layout the image will be in when sampled.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorWriter& writeCombinedImageSampler(
+            DescriptorSet const& descriptorSet,
+            uint32_t const binding,
+            VkSampler const sampler,
+            std::shared_ptr<ImageView> const& imageView,
+            VkImageLayout const imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Write a sampler descriptor.
+         * @param descriptorSet The descriptor set to write to.
+         * @param binding The index of the binding to write.
+         * @param sampler The sampler to bind.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorWriter& writeSampler(
+            DescriptorSet const& descriptorSet,
+            uint32_t const binding,
+            VkSampler const sampler,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Write a texel buffer descriptor.
+         * @param descriptorSet The descriptor set to write to.
+         * @param binding The index of the binding to write.
+         * @param bufferView View of the buffer to bind.
+         * @param descriptorType Either VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER or VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER.
+         * @param arrayElement Index within the binding's descriptor array.
+         * @return Reference to this object.
+         */
+        DescriptorWriter& writeTexelBuffer(
+            DescriptorSet const& descriptorSet,
+            uint32_t const binding,
+            VkBufferView const bufferView,
+            VkDescriptorType const descriptorType,
+            uint32_t const arrayElement = 0);
+
+        /**
+         * @brief Write every resource in a set of bindings.
+         * @param descriptorSet The descriptor set to write to.
+         * @param bindings Resources to bind.
+         * @return Reference to this object.
+         */
+        DescriptorWriter& writeBindings(DescriptorSet const& descriptorSet, DescriptorSetBindings const& bindings);
+
+        /**
+         * @brief Get the number of writes waiting to be flushed.
+         */
+        std::size_t size() const {
+            return this->writes.size();
+        }
+
+        /**
+         * @brief Apply all pending writes with one vkUpdateDescriptorSets call, then clear them.
+         */
+        void flush();
+
+        /**
+         * @brief Discard all pending writes.
+         */
+        void clear();
+    };
+
+}
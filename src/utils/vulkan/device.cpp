@@ -2,34 +2,55 @@
 
 #include "vulkan/vulkan.h"
 
+#include <algorithm>
+
 
 namespace utils::vulkan {
 
     utils::Logger Device::log = Logger("Device");
 
 
-    std::map<uint32_t, std::vector<std::string>> getQueueFamilyMap(std::map<std::string, uint32_t> const& queueFamilyIndexMap) {
+    /**
+     * @brief Assign named queues to queue indices within their families.
+     * Names are assigned in order of decreasing priority, one per index. Once a family runs out
+     * of queues, the remaining (lowest priority) names share its last queue.
+     * @return Map of family index to the names assigned to each queue index in the family.
+     */
+    std::map<uint32_t, std::vector<std::vector<std::string>>> getQueueAssignments(std::map<std::string, QueueRequest> const& queueRequests) {
         std::map<uint32_t, std::vector<std::string>> queueFamilyMap;
 
-        for (auto const& entry : queueFamilyIndexMap) {
-            auto const& queueName = entry.first;
-            auto const& queueFamilyIndex = entry.second;
+        for (auto const& entry : queueRequests) {
+            queueFamilyMap[entry.second.familyIndex].push_back(entry.first);
+        }
 
-            if (queueFamilyMap.find(queueFamilyIndex) == queueFamilyMap.end()) {
-                queueFamilyMap[queueFamilyIndex] = std::vector<std::string>();
-            }
+        std::map<uint32_t, std::vector<std::vector<std::string>>> queueAssignments;
+
+        for (auto& entry : queueFamilyMap) {
+            auto& queueNames = entry.second;
+
+            std::stable_sort(queueNames.begin(), queueNames.end(), [&](std::string const& a, std::string const& b) {
+                return queueRequests.at(a).priority > queueRequests.at(b).priority;
+            });
 
-            queueFamilyMap[queueFamilyIndex].push_back(queueName);
+            uint32_t const familyQueueCount = queueRequests.at(queueNames.front()).familyQueueCount;
+            uint32_t const queueCount = std::min(static_cast<uint32_t>(queueNames.size()), familyQueueCount);
+
+            auto& familyAssignments = queueAssignments[entry.first];
+            familyAssignments.resize(queueCount);
+
+            for (unsigned i = 0; i < queueNames.size(); i++) {
+                familyAssignments[std::min(i, queueCount - 1)].push_back(queueNames[i]);
+            }
         }
 
-        return queueFamilyMap;
+        return queueAssignments;
     }
 
 
     Device::Device(
         std::shared_ptr<InstanceHandle> const& vkInstanceHandle,
         VkPhysicalDevice const& physicalDevice,
-        std::map<std::string, uint32_t> const& queueFamilyIndexMap,
+        std::map<std::string, QueueRequest> const& queueRequests,
         std::vector<std::string> const& deviceExtensions,
         std::vector<std::string> const& validationLayerNames
     ) :
@@ -39,31 +60,125 @@ namespace utils::vulkan {
     {
         INFO(log) << "Creating logical device." << std::endl;
 
-        auto const queueFamilyMap = getQueueFamilyMap(queueFamilyIndexMap);
+        auto const queueAssignments = getQueueAssignments(queueRequests);
 
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-        float queuePriority = 1.0f;
+        std::map<uint32_t, std::vector<float>> queuePriorities;
 
-        for (auto const& entry : queueFamilyMap) {
-            uint32_t queueFamilyIndex = entry.first;
-            uint32_t queueFamilyFrequency = entry.second.size();
+        for (auto const& entry : queueAssignments) {
+            uint32_t const queueFamilyIndex = entry.first;
+            auto const& familyAssignments = entry.second;
+
+            // A shared queue gets the highest priority of the names assigned to it
+            auto& familyPriorities = queuePriorities[queueFamilyIndex];
+
+            for (auto const& queueNames : familyAssignments) {
+                float priority = 0.0f;
+
+                for (auto const& queueName : queueNames) {
+                    priority = std::max(priority, queueRequests.at(queueName).priority);
+                }
+
+                familyPriorities.push_back(priority);
+            }
 
             VkDeviceQueueCreateInfo queueCreateInfo {};
             queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
             queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
-            queueCreateInfo.queueCount = queueFamilyFrequency;
-            queueCreateInfo.pQueuePriorities = &queuePriority;
+            queueCreateInfo.queueCount = static_cast<uint32_t>(familyPriorities.size());
+            queueCreateInfo.pQueuePriorities = familyPriorities.data();
 
             queueCreateInfos.push_back(queueCreateInfo);
         }
 
+        VkPhysicalDeviceFeatures supportedFeatures;
+        vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
+        // Indirect drawing with more than one draw per call needs these
         VkPhysicalDeviceFeatures deviceFeatures {};
+        deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+        deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+
+        // Bindless tables are indexed by values from push constants or instance data
+        deviceFeatures.shaderSampledImageArrayDynamicIndexing = supportedFeatures.shaderSampledImageArrayDynamicIndexing;
+        deviceFeatures.shaderStorageBufferArrayDynamicIndexing = supportedFeatures.shaderStorageBufferArrayDynamicIndexing;
 
         auto const validationLayerParams = StringParameters(validationLayerNames);
         auto const deviceExtensionParams = StringParameters(deviceExtensions);
 
+        auto const isExtensionEnabled = [&](char const * const extensionName) {
+            return std::find(deviceExtensions.begin(), deviceExtensions.end(), extensionName) != deviceExtensions.end();
+        };
+
+        // Extension feature structures are chained onto the create info
+        void * featureChain = nullptr;
+
+        auto const addFeatures = [&](auto& features) {
+            features.pNext = featureChain;
+            featureChain = &features;
+        };
+
+        // The timelineSemaphore feature is mandatory when the extension is supported
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures {};
+        timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+
+        if (isExtensionEnabled(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+            addFeatures(timelineSemaphoreFeatures);
+        }
+
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures {};
+        extendedDynamicStateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        extendedDynamicStateFeatures.extendedDynamicState = VK_TRUE;
+
+        if (isExtensionEnabled(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME)) {
+            addFeatures(extendedDynamicStateFeatures);
+        }
+
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT extendedDynamicState2Features {};
+        extendedDynamicState2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+        extendedDynamicState2Features.extendedDynamicState2 = VK_TRUE;
+
+        if (isExtensionEnabled(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME)) {
+            addFeatures(extendedDynamicState2Features);
+        }
+
+        // Every extended dynamic state 3 feature is optional, so these are only known after the query below
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT extendedDynamicState3Features {};
+        extendedDynamicState3Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+
+        if (isExtensionEnabled(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+            addFeatures(extendedDynamicState3Features);
+        }
+
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures {};
+        graphicsPipelineLibraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+        if (isExtensionEnabled(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) && isExtensionEnabled(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+            addFeatures(graphicsPipelineLibraryFeatures);
+        }
+
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures {};
+        descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+        if (isExtensionEnabled(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) && isExtensionEnabled(VK_KHR_MAINTENANCE3_EXTENSION_NAME)) {
+            addFeatures(descriptorIndexingFeatures);
+        }
+
+        // Fill the chain with what the device supports, then pass it on as is to enable all of it
+        auto const getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+            vkGetInstanceProcAddr(vkInstanceHandle->vk, "vkGetPhysicalDeviceFeatures2KHR"));
+
+        if (featureChain != nullptr && getPhysicalDeviceFeatures2 != nullptr) {
+            VkPhysicalDeviceFeatures2KHR features2 {};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+            features2.pNext = featureChain;
+            getPhysicalDeviceFeatures2(physicalDevice, &features2);
+        }
+
         VkDeviceCreateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = featureChain;
         createInfo.pEnabledFeatures = &deviceFeatures;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
@@ -76,19 +191,62 @@ namespace utils::vulkan {
             throw std::runtime_error("Failed to create logical device.");
         }
 
-        populateQueueMap(queueFamilyMap);
+        this->vkHandle->functions.load(this->vkHandle->vk, deviceExtensions, extendedDynamicState3Features);
+        this->graphicsPipelineLibrary = graphicsPipelineLibraryFeatures.graphicsPipelineLibrary == VK_TRUE;
+
+        // Everything a bindless table relies on
+        this->descriptorIndexing =
+            deviceFeatures.shaderSampledImageArrayDynamicIndexing == VK_TRUE &&
+            deviceFeatures.shaderStorageBufferArrayDynamicIndexing == VK_TRUE &&
+            descriptorIndexingFeatures.runtimeDescriptorArray == VK_TRUE &&
+            descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing == VK_TRUE &&
+            descriptorIndexingFeatures.shaderStorageBufferArrayNonUniformIndexing == VK_TRUE &&
+            descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+            descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE &&
+            descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending == VK_TRUE &&
+            descriptorIndexingFeatures.descriptorBindingPartiallyBound == VK_TRUE &&
+            descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount == VK_TRUE;
+
+        // The limits are needed to validate bindless table capacities
+        auto const getPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+            vkGetInstanceProcAddr(vkInstanceHandle->vk, "vkGetPhysicalDeviceProperties2KHR"));
+
+        if (this->descriptorIndexing && getPhysicalDeviceProperties2 != nullptr) {
+            this->descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+            VkPhysicalDeviceProperties2KHR properties2 {};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+            properties2.pNext = &this->descriptorIndexingProperties;
+            getPhysicalDeviceProperties2(physicalDevice, &properties2);
+        } else {
+            this->descriptorIndexing = false;
+        }
+
+        populateQueueMap(queueAssignments);
+
+        this->pipelineCache = std::make_shared<PipelineCache>(this->vkHandle, this->getPhysicalDeviceProperties());
+        this->shaderModuleCache = std::make_shared<ShaderModuleCache>(this->vkHandle);
+        this->layoutCache = std::make_shared<LayoutCache>(this->vkHandle);
     }
 
 
-    void Device::populateQueueMap(std::map<uint32_t, std::vector<std::string>> const& queueFamilyMap) {
-        for (auto const& entry : queueFamilyMap) {
+    void Device::populateQueueMap(std::map<uint32_t, std::vector<std::vector<std::string>>> const& queueAssignments) {
+        for (auto const& entry : queueAssignments) {
             auto const& queueFamilyIndex = entry.first;
-            auto const& queueNames = entry.second;
+            auto const& familyAssignments = entry.second;
 
-            for (unsigned i = 0; i < queueNames.size(); i++) {
-                auto const& queueName = queueNames[i];
-                auto const queue = std::make_shared<Queue>(this->vkHandle, queueFamilyIndex, i, queueNames[i]);
-                this->queueMap.insert(std::make_pair(queueName, queue));
+            for (unsigned i = 0; i < familyAssignments.size(); i++) {
+                auto const& queueNames = familyAssignments[i];
+                auto const queue = std::make_shared<Queue>(this->vkHandle, queueFamilyIndex, i, queueNames.front());
+
+                // Names beyond the family's queue count share a queue, which is safe as Queue is synchronized
+                for (auto const& queueName : queueNames) {
+                    if (queueName != queue->name) {
+                        INFO(log) << "Queue '" << queueName << "' shares queue '" << queue->name << "'" << std::endl;
+                    }
+
+                    this->queueMap.insert(std::make_pair(queueName, queue));
+                }
             }
         }
     }
@@ -103,6 +261,34 @@ namespace utils::vulkan {
     }
 
 
+    VkPhysicalDeviceProperties Device::getPhysicalDeviceProperties() const {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(this->vkPhysicalDevice, &properties);
+        return properties;
+    }
+
+
+    bool Device::supportsDynamicState(VkDynamicState const dynamicState) const {
+        return this->vkHandle->functions.supportsDynamicState(dynamicState);
+    }
+
+
+    bool Device::supportsDrawIndirectCount() const {
+        auto const& functions = this->vkHandle->functions;
+        return functions.vkCmdDrawIndirectCount != nullptr && functions.vkCmdDrawIndexedIndirectCount != nullptr;
+    }
+
+
+    void Device::loadPipelineCache(std::filesystem::path const& path) {
+        this->pipelineCache = std::make_shared<PipelineCache>(this->vkHandle, this->getPhysicalDeviceProperties(), path);
+    }
+
+
+    void Device::savePipelineCache(std::filesystem::path const& path) const {
+        this->pipelineCache->save(path);
+    }
+
+
     std::shared_ptr<SwapChain> Device::createSwapChain(
         std::shared_ptr<Surface> const& surface,
         SwapChainConfig const& swapChainConfig
@@ -112,7 +298,17 @@ namespace utils::vulkan {
 
 
     std::shared_ptr<ShaderModule> Device::createShaderModule(std::filesystem::path const& path) const {
-        return std::make_shared<ShaderModule>(this->vkHandle, path);
+        return this->shaderModuleCache->get(path);
+    }
+
+
+    std::shared_ptr<ShaderModule> Device::createShaderModule(std::vector<uint32_t> const& code) const {
+        return this->shaderModuleCache->get(code);
+    }
+
+
+    std::shared_ptr<ShaderModule> Device::createShaderModule(EmbeddedShader const& shader) const {
+        return this->shaderModuleCache->get(shader.getCode());
     }
 
 
@@ -121,6 +317,11 @@ namespace utils::vulkan {
     }
 
 
+    std::shared_ptr<PipelineLayout> Device::createPipelineLayout(ShaderReflection const& reflection) const {
+        return this->layoutCache->getPipelineLayout(reflection);
+    }
+
+
     std::shared_ptr<RenderPass> Device::createRenderPass(RenderPassConfig const& config) const {
         return std::make_shared<RenderPass>(this->vkHandle, config);
     }
@@ -132,7 +333,90 @@ namespace utils::vulkan {
         GraphicsPipelineConfig const& config
     ) const {
         return std::make_shared<GraphicsPipeline>(
-            this->vkHandle, pipelineLayout->getHandle(), renderPass->getHandle(), config);
+            this->vkHandle, this->pipelineCache->getHandle(), pipelineLayout->getHandle(), renderPass->getHandle(), config);
+    }
+
+
+    std::shared_ptr<GraphicsPipelineLibrary> Device::createGraphicsPipelineLibrary(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        std::shared_ptr<RenderPass> const& renderPass,
+        GraphicsPipelineConfig const& config,
+        VkGraphicsPipelineLibraryFlagsEXT const parts
+    ) const {
+        if (!this->graphicsPipelineLibrary) {
+            throw std::runtime_error("Unable to create graphics pipeline library, VK_EXT_graphics_pipeline_library is not enabled.");
+        }
+
+        return std::make_shared<GraphicsPipelineLibrary>(
+            this->vkHandle,
+            this->pipelineCache->getHandle(),
+            pipelineLayout != nullptr ? pipelineLayout->getHandle() : nullptr,
+            renderPass != nullptr ? renderPass->getHandle() : nullptr,
+            config,
+            parts);
+    }
+
+
+    std::shared_ptr<GraphicsPipeline> Device::linkGraphicsPipeline(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        std::shared_ptr<RenderPass> const& renderPass,
+        GraphicsPipelineConfig const& config,
+        std::vector<std::shared_ptr<GraphicsPipelineLibrary>> const& libraries,
+        bool const optimize
+    ) const {
+        return std::make_shared<GraphicsPipeline>(
+            this->vkHandle,
+            this->pipelineCache->getHandle(),
+            pipelineLayout->getHandle(),
+            renderPass->getHandle(),
+            config,
+            libraries,
+            optimize);
+    }
+
+
+    std::shared_ptr<ComputePipeline> Device::createComputePipeline(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        ComputePipelineConfig const& config
+    ) const {
+        return std::make_shared<ComputePipeline>(
+            this->vkHandle, this->pipelineCache->getHandle(), pipelineLayout->getHandle(), config);
+    }
+
+
+    std::future<std::shared_ptr<GraphicsPipeline>> Device::createGraphicsPipelineAsync(
+        utils::ThreadPool& threadPool,
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        std::shared_ptr<RenderPass> const& renderPass,
+        GraphicsPipelineConfig const& config
+    ) const {
+        // Capture handles by value, so the task doesn't depend on this object outliving it
+        return threadPool.submit([
+            vkHandle = this->vkHandle,
+            vkPipelineCacheHandle = this->pipelineCache->getHandle(),
+            vkPipelineLayoutHandle = pipelineLayout->getHandle(),
+            vkRenderPassHandle = renderPass->getHandle(),
+            config
+        ] {
+            return std::make_shared<GraphicsPipeline>(
+                vkHandle, vkPipelineCacheHandle, vkPipelineLayoutHandle, vkRenderPassHandle, config);
+        });
+    }
+
+
+    std::future<std::shared_ptr<ComputePipeline>> Device::createComputePipelineAsync(
+        utils::ThreadPool& threadPool,
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        ComputePipelineConfig const& config
+    ) const {
+        return threadPool.submit([
+            vkHandle = this->vkHandle,
+            vkPipelineCacheHandle = this->pipelineCache->getHandle(),
+            vkPipelineLayoutHandle = pipelineLayout->getHandle(),
+            config
+        ] {
+            return std::make_shared<ComputePipeline>(vkHandle, vkPipelineCacheHandle, vkPipelineLayoutHandle, config);
+        });
     }
 
 
@@ -145,7 +429,17 @@ namespace utils::vulkan {
 
 
     std::shared_ptr<CommandPool> Device::createCommandPool(CommandPoolConfig const& config) const {
-        return std::make_shared<CommandPool>(this->vkHandle, config);
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(this->vkPhysicalDevice, &queueFamilyCount, nullptr);
+
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(this->vkPhysicalDevice, &queueFamilyCount, queueFamilies.data());
+
+        if (config.queueFamilyIndex >= queueFamilyCount) {
+            throw std::runtime_error("invalid queue family index for command pool.");
+        }
+
+        return std::make_shared<CommandPool>(this->vkHandle, config, queueFamilies[config.queueFamilyIndex].queueFlags);
     }
 
 
@@ -154,6 +448,11 @@ namespace utils::vulkan {
     }
 
 
+    std::shared_ptr<TimelineSemaphore> Device::createTimelineSemaphore(uint64_t const initialValue) const {
+        return std::make_shared<TimelineSemaphore>(this->vkHandle, initialValue);
+    }
+
+
     std::shared_ptr<Fence> Device::createFence(VkFenceCreateFlagBits const flags) const {
         return std::make_shared<Fence>(this->vkHandle, flags);
     }
@@ -170,7 +469,7 @@ namespace utils::vulkan {
 
 
     std::shared_ptr<DescriptorSetLayout> Device::createDescriptorSetLayout(DescriptorSetLayoutConfig const& config) const {
-        return std::make_shared<DescriptorSetLayout>(this->vkHandle, config);
+        return this->layoutCache->getDescriptorSetLayout(config);
     }
 
 
@@ -179,6 +478,67 @@ namespace utils::vulkan {
     }
 
 
+    std::shared_ptr<DescriptorAllocator> Device::createDescriptorAllocator(
+        DescriptorAllocatorConfig const& config,
+        uint32_t const frameCount
+    ) const {
+        return std::make_shared<DescriptorAllocator>(this->vkHandle, config, frameCount);
+    }
+
+
+    std::shared_ptr<DescriptorSetCache> Device::createDescriptorSetCache(DescriptorAllocatorConfig const& config) const {
+        return std::make_shared<DescriptorSetCache>(this->vkHandle, config);
+    }
+
+
+    std::shared_ptr<DescriptorWriter> Device::createDescriptorWriter() const {
+        return std::make_shared<DescriptorWriter>(this->vkHandle);
+    }
+
+
+    std::shared_ptr<DescriptorUpdateTemplate> Device::createDescriptorUpdateTemplate(
+        std::shared_ptr<DescriptorSetLayout> const& layout,
+        DescriptorUpdateTemplateConfig const& config
+    ) const {
+        return std::make_shared<DescriptorUpdateTemplate>(this->vkHandle, layout, config);
+    }
+
+
+    std::shared_ptr<BindlessTable> Device::createBindlessTable(BindlessTableConfig const& config) const {
+        if (!this->descriptorIndexing) {
+            throw std::runtime_error("Unable to create bindless table, descriptor indexing is not supported.");
+        }
+
+        auto const& limits = this->descriptorIndexingProperties;
+
+        // The table is a single set, and every stage in stageFlags sees all of it
+        if (
+            config.bufferCapacity > limits.maxDescriptorSetUpdateAfterBindStorageBuffers ||
+            config.bufferCapacity > limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers
+        ) {
+            throw std::runtime_error("Unable to create bindless table, buffer capacity exceeds the device limit.");
+        }
+
+        if (
+            config.imageCapacity > limits.maxDescriptorSetUpdateAfterBindSampledImages ||
+            config.imageCapacity > limits.maxPerStageDescriptorUpdateAfterBindSampledImages
+        ) {
+            throw std::runtime_error("Unable to create bindless table, image capacity exceeds the device limit.");
+        }
+
+        uint64_t const totalCapacity = static_cast<uint64_t>(config.bufferCapacity) + config.imageCapacity;
+
+        if (
+            totalCapacity > limits.maxPerStageUpdateAfterBindResources ||
+            totalCapacity > limits.maxUpdateAfterBindDescriptorsInAllPools
+        ) {
+            throw std::runtime_error("Unable to create bindless table, total capacity exceeds the device limit.");
+        }
+
+        return std::make_shared<BindlessTable>(this->vkHandle, config);
+    }
+
+
     std::shared_ptr<Image> Device::createImage(ImageConfig const& config) const {
         return std::make_shared<Image>(this->vkHandle, config);
     }
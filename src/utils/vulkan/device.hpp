@@ -4,19 +4,31 @@
 #include "utils/vulkan/queue.hpp"
 #include "utils/vulkan/swap_chain.hpp"
 #include "utils/vulkan/shader_module.hpp"
+#include "utils/vulkan/shader_module_cache.hpp"
+#include "utils/vulkan/embedded_shader.hpp"
 #include "utils/vulkan/pipeline_layout.hpp"
+#include "utils/vulkan/layout_cache.hpp"
 #include "utils/vulkan/render_pass.hpp"
 #include "utils/vulkan/graphics_pipeline.hpp"
+#include "utils/vulkan/compute_pipeline.hpp"
+#include "utils/vulkan/pipeline_cache.hpp"
 #include "utils/vulkan/frame_buffer.hpp"
 #include "utils/vulkan/command_pool.hpp"
 #include "utils/vulkan/semaphore.hpp"
+#include "utils/vulkan/timeline_semaphore.hpp"
 #include "utils/vulkan/fence.hpp"
 #include "utils/vulkan/buffer.hpp"
 #include "utils/vulkan/device_memory.hpp"
 #include "utils/vulkan/descriptor_set_layout.hpp"
 #include "utils/vulkan/descriptor_pool.hpp"
+#include "utils/vulkan/descriptor_allocator.hpp"
+#include "utils/vulkan/descriptor_set_cache.hpp"
+#include "utils/vulkan/descriptor_writer.hpp"
+#include "utils/vulkan/descriptor_update_template.hpp"
+#include "utils/vulkan/bindless_table.hpp"
 
 #include "utils/misc/logging.hpp"
+#include "utils/misc/thread_pool.hpp"
 
 #include "vulkan/vulkan.h"
 
@@ -24,6 +36,7 @@
 #include <optional>
 #include <memory>
 #include <filesystem>
+#include <future>
 
 
 namespace utils::vulkan {
@@ -37,22 +50,42 @@ namespace utils::vulkan {
 
         std::map<std::string, std::shared_ptr<Queue>> queueMap;
 
+        // Used for every pipeline created through this device
+        std::shared_ptr<PipelineCache> pipelineCache;
+
+        // Shares modules between identical shaders
+        std::shared_ptr<ShaderModuleCache> shaderModuleCache;
+
+        // Shares descriptor set and pipeline layouts with identical contents
+        std::shared_ptr<LayoutCache> layoutCache;
+
+        // Whether VK_EXT_graphics_pipeline_library is enabled and usable
+        bool graphicsPipelineLibrary = false;
+
+        // Whether VK_EXT_descriptor_indexing is enabled with every feature bindless tables need
+        bool descriptorIndexing = false;
+
+        // Update after bind limits bindless tables must stay within, only valid if descriptorIndexing is set
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties {};
+
     private:
-        void populateQueueMap(std::map<uint32_t, std::vector<std::string>> const& queueFamilyMap);
+        void populateQueueMap(std::map<uint32_t, std::vector<std::vector<std::string>>> const& queueAssignments);
+
+        VkPhysicalDeviceProperties getPhysicalDeviceProperties() const;
 
     public:
         /**
          * @brief Construct and initialize a new logical device instance.
          * @param vkInstanceHandle std::shared_ptr to utils::vulkan::Instance.
          * @param physicalDevice VkPhysicalDevice object instance designating the desired GPU.
-         * @param queueFamilyIndexMap Map of queue names to queue family indices.
+         * @param queueRequests Map of queue names to queue families and priorities.
          * @param deviceExtensions Vector of strings specifying required device extensions.
          * @param validationLayerNames Vector of strings containing device validation layers (optional).
          */
         Device(
             std::shared_ptr<InstanceHandle> const& vkInstanceHandle,
             VkPhysicalDevice const& physicalDevice,
-            std::map<std::string, uint32_t> const& queueFamilyIndexMap,
+            std::map<std::string, QueueRequest> const& queueRequests,
             std::vector<std::string> const& deviceExtensions,
             std::vector<std::string> const& validationLayerNames = std::vector<std::string>());
 
@@ -74,11 +107,28 @@ namespace utils::vulkan {
 
         /**
          * @brief Create a new shader module from an spv file on disk.
+         * Modules are cached, so loading an unchanged file again returns the existing module.
          * @param path Path to the source SPIRV file to create the shader from.
          * @return Shared pointer to shader module object.
          */
         std::shared_ptr<ShaderModule> createShaderModule(std::filesystem::path const& path) const;
 
+        /**
+         * @brief Create a new shader module from SPIR-V code in memory.
+         * Modules are cached, so the same code returns the existing module.
+         * @param code SPIR-V words.
+         * @return Shared pointer to shader module object.
+         */
+        std::shared_ptr<ShaderModule> createShaderModule(std::vector<uint32_t> const& code) const;
+
+        /**
+         * @brief Create a new shader module from SPIR-V embedded in the binary.
+         * Modules are cached, so the same code returns the existing module.
+         * @param shader Embedded shader, see getEmbeddedShader.
+         * @return Shared pointer to shader module object.
+         */
+        std::shared_ptr<ShaderModule> createShaderModule(EmbeddedShader const& shader) const;
+
         /**
          * @brief Create a new pipeline layout with the provided configuration.
          * @param config Pipeline layout config object.
@@ -86,6 +136,21 @@ namespace utils::vulkan {
          */
         std::shared_ptr<PipelineLayout> createPipelineLayout(PipelineLayoutConfig const& config) const;
 
+        /**
+         * @brief Get a pipeline layout matching the interface of a set of shaders.
+         * Layouts are cached, so shaders with identical interfaces share one layout.
+         * @param reflection Reflection of every stage of the pipeline, merged.
+         * @return Shared pointer to pipeline layout object.
+         */
+        std::shared_ptr<PipelineLayout> createPipelineLayout(ShaderReflection const& reflection) const;
+
+        /**
+         * @brief Get the cache used for layouts built from shader reflection.
+         */
+        std::shared_ptr<LayoutCache> const& getLayoutCache() const {
+            return this->layoutCache;
+        }
+
         /**
          * @brief Create a new render pass.
          * @param config Render pass config object containing details of the render pass.
@@ -93,6 +158,38 @@ namespace utils::vulkan {
          */
         std::shared_ptr<RenderPass> createRenderPass(RenderPassConfig const& config) const;
 
+        /**
+         * @brief Check whether a piece of pipeline state can be made dynamic on this device.
+         * @param dynamicState The dynamic state to check.
+         */
+        bool supportsDynamicState(VkDynamicState const dynamicState) const;
+
+        /**
+         * @brief Check whether indirect draws can read their draw count from a buffer.
+         */
+        bool supportsDrawIndirectCount() const;
+
+        /**
+         * @brief Replace the device's pipeline cache with one seeded from disk.
+         * Should be called before any pipelines are created, as their entries are not carried over.
+         * @param path Path to saved cache data, missing or incompatible files are ignored.
+         */
+        void loadPipelineCache(std::filesystem::path const& path);
+
+        /**
+         * @brief Write the device's pipeline cache to disk.
+         * @param path Path to write the cache data to.
+         */
+        void savePipelineCache(std::filesystem::path const& path) const;
+
+        /**
+         * @brief Get the pipeline cache used for pipeline creation.
+         * @return Shared pointer to the pipeline cache.
+         */
+        std::shared_ptr<PipelineCache> const& getPipelineCache() const {
+            return this->pipelineCache;
+        }
+
         /**
          * @brief Create a new graphics pipeline.
          * @param config Graphics pipeline config object containing pipeline details.
@@ -105,6 +202,89 @@ namespace utils::vulkan {
             std::shared_ptr<RenderPass> const& renderPass,
             GraphicsPipelineConfig const& config) const;
 
+        /**
+         * @brief Check whether graphics pipelines can be built from separately compiled libraries.
+         */
+        bool supportsGraphicsPipelineLibrary() const {
+            return this->graphicsPipelineLibrary;
+        }
+
+        /**
+         * @brief Check whether bindless tables can be created.
+         */
+        bool supportsDescriptorIndexing() const {
+            return this->descriptorIndexing;
+        }
+
+        /**
+         * @brief Compile some parts of a graphics pipeline into a library.
+         * Requires VK_EXT_graphics_pipeline_library to be enabled on the device.
+         * @param pipelineLayout Pipeline layout, may be nullptr for vertex input and fragment output parts.
+         * @param renderPass Render pass, may be nullptr for the vertex input part.
+         * @param config Graphics pipeline config, only state belonging to the parts is used.
+         * @param parts Pipeline parts to compile (VK_GRAPHICS_PIPELINE_LIBRARY_*_BIT_EXT).
+         * @return Shared pointer to new graphics pipeline library object.
+         */
+        std::shared_ptr<GraphicsPipelineLibrary> createGraphicsPipelineLibrary(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            std::shared_ptr<RenderPass> const& renderPass,
+            GraphicsPipelineConfig const& config,
+            VkGraphicsPipelineLibraryFlagsEXT const parts) const;
+
+        /**
+         * @brief Link a complete graphics pipeline from libraries.
+         * @param pipelineLayout Shared pointer to valid pipeline layout object.
+         * @param renderPass Shared pointer to valid render pass object.
+         * @param config Graphics pipeline config the libraries were created from.
+         * @param libraries Libraries which together contain every pipeline part.
+         * @param optimize Perform link time optimization, slower to link but faster to run.
+         * @return Shared pointer to new graphics pipeline object.
+         */
+        std::shared_ptr<GraphicsPipeline> linkGraphicsPipeline(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            std::shared_ptr<RenderPass> const& renderPass,
+            GraphicsPipelineConfig const& config,
+            std::vector<std::shared_ptr<GraphicsPipelineLibrary>> const& libraries,
+            bool const optimize) const;
+
+        /**
+         * @brief Create a new compute pipeline.
+         * @param pipelineLayout Shared pointer to valid pipeline layout object.
+         * @param config Compute pipeline config object containing pipeline details.
+         * @return Shared pointer to new compute pipeline object.
+         */
+        std::shared_ptr<ComputePipeline> createComputePipeline(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            ComputePipelineConfig const& config) const;
+
+        /**
+         * @brief Create a new graphics pipeline on a worker thread.
+         * Pipelines created concurrently share the device's pipeline cache, which is
+         * internally synchronized. The cache must not be replaced while creation is in flight.
+         * @param threadPool Thread pool to compile the pipeline on.
+         * @param pipelineLayout Shared pointer to valid pipeline layout object.
+         * @param renderPass Shared pointer to valid render pass object.
+         * @param config Graphics pipeline config object containing pipeline details.
+         * @return Future holding the new graphics pipeline object.
+         */
+        std::future<std::shared_ptr<GraphicsPipeline>> createGraphicsPipelineAsync(
+            utils::ThreadPool& threadPool,
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            std::shared_ptr<RenderPass> const& renderPass,
+            GraphicsPipelineConfig const& config) const;
+
+        /**
+         * @brief Create a new compute pipeline on a worker thread.
+         * @param threadPool Thread pool to compile the pipeline on.
+         * @param pipelineLayout Shared pointer to valid pipeline layout object.
+         * @param config Compute pipeline config object containing pipeline details.
+         * @return Future holding the new compute pipeline object.
+         */
+        std::future<std::shared_ptr<ComputePipeline>> createComputePipelineAsync(
+            utils::ThreadPool& threadPool,
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            ComputePipelineConfig const& config) const;
+
         /**
          * @brief Create a new frame buffer from an image view.
          * @param imageView Shared pointer to image view to create frame buffer from.
@@ -126,6 +306,14 @@ namespace utils::vulkan {
          */
         std::shared_ptr<Semaphore> createSemaphore() const;
 
+        /**
+         * @brief Create a new timeline semaphore object.
+         * Requires VK_KHR_timeline_semaphore to be enabled on the device.
+         * @param initialValue Initial value of the semaphore counter.
+         * @return Shared pointer to new timeline semaphore object.
+         */
+        std::shared_ptr<TimelineSemaphore> createTimelineSemaphore(uint64_t const initialValue = 0) const;
+
         /**
          * @brief Create a new fence object.
          * @param flags Fence create flags.
@@ -152,6 +340,7 @@ namespace utils::vulkan {
 
         /**
          * @brief Create a new descriptor set layout.
+         * Layouts are cached, so a config with the same bindings returns the existing layout.
          * @param config Descriptor set layout configuration structure.
          */
         std::shared_ptr<DescriptorSetLayout> createDescriptorSetLayout(DescriptorSetLayoutConfig const& config) const;
@@ -162,6 +351,44 @@ namespace utils::vulkan {
          */
         std::shared_ptr<DescriptorPool> createDescriptorPool(DescriptorPoolConfig const& config) const;
 
+        /**
+         * @brief Create new allocator for transient per-frame descriptor sets.
+         * @param config Descriptor allocator configuration structure.
+         * @param frameCount Number of frames in flight.
+         */
+        std::shared_ptr<DescriptorAllocator> createDescriptorAllocator(
+            DescriptorAllocatorConfig const& config,
+            uint32_t const frameCount) const;
+
+        /**
+         * @brief Create new cache of descriptor sets, shared between users binding identical resources.
+         * @param config Descriptor pool sizing for the cache's sets.
+         */
+        std::shared_ptr<DescriptorSetCache> createDescriptorSetCache(DescriptorAllocatorConfig const& config) const;
+
+        /**
+         * @brief Create new writer for batching descriptor updates.
+         */
+        std::shared_ptr<DescriptorWriter> createDescriptorWriter() const;
+
+        /**
+         * @brief Create new descriptor update template.
+         * Requires VK_KHR_descriptor_update_template to be enabled on the device.
+         * @param layout Layout of the descriptor sets the template will write.
+         * @param config Descriptor update template configuration structure.
+         */
+        std::shared_ptr<DescriptorUpdateTemplate> createDescriptorUpdateTemplate(
+            std::shared_ptr<DescriptorSetLayout> const& layout,
+            DescriptorUpdateTemplateConfig const& config) const;
+
+        /**
+         * @brief Create new bindless resource table.
+         * Requires VK_EXT_descriptor_indexing to be enabled on the device, and the capacities
+         * to be within the device's update after bind descriptor limits.
+         * @param config Bindless table configuration structure.
+         */
+        std::shared_ptr<BindlessTable> createBindlessTable(BindlessTableConfig const& config) const;
+
         /**
          * @brief Create the thing.
          * @param config Image configuration.
@@ -0,0 +1,112 @@
+#include "utils/vulkan/device_functions.hpp"
+
+#include <algorithm>
+
+
+namespace utils::vulkan {
+
+    template<typename T>
+    void loadDeviceFunction(VkDevice const device, char const * const name, T * const functionOut) {
+        *functionOut = reinterpret_cast<T>(vkGetDeviceProcAddr(device, name));
+    }
+
+
+    void DeviceFunctions::load(
+        VkDevice const device,
+        std::vector<std::string> const& enabledExtensions,
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT const& extendedDynamicState3Features
+    ) {
+        auto const isEnabled = [&](char const * const extensionName) {
+            return std::find(enabledExtensions.begin(), enabledExtensions.end(), extensionName) != enabledExtensions.end();
+        };
+
+        if (isEnabled(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)) {
+            loadDeviceFunction(device, "vkCmdDrawIndirectCountKHR", &this->vkCmdDrawIndirectCount);
+            loadDeviceFunction(device, "vkCmdDrawIndexedIndirectCountKHR", &this->vkCmdDrawIndexedIndirectCount);
+        }
+
+        if (isEnabled(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+            loadDeviceFunction(device, "vkGetSemaphoreCounterValueKHR", &this->vkGetSemaphoreCounterValue);
+            loadDeviceFunction(device, "vkWaitSemaphoresKHR", &this->vkWaitSemaphores);
+            loadDeviceFunction(device, "vkSignalSemaphoreKHR", &this->vkSignalSemaphore);
+        }
+
+        if (isEnabled(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME)) {
+            loadDeviceFunction(device, "vkCmdSetCullModeEXT", &this->vkCmdSetCullMode);
+            loadDeviceFunction(device, "vkCmdSetFrontFaceEXT", &this->vkCmdSetFrontFace);
+            loadDeviceFunction(device, "vkCmdSetPrimitiveTopologyEXT", &this->vkCmdSetPrimitiveTopology);
+            loadDeviceFunction(device, "vkCmdSetDepthTestEnableEXT", &this->vkCmdSetDepthTestEnable);
+            loadDeviceFunction(device, "vkCmdSetDepthWriteEnableEXT", &this->vkCmdSetDepthWriteEnable);
+            loadDeviceFunction(device, "vkCmdSetDepthCompareOpEXT", &this->vkCmdSetDepthCompareOp);
+        }
+
+        if (isEnabled(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME)) {
+            loadDeviceFunction(device, "vkCmdSetDepthBiasEnableEXT", &this->vkCmdSetDepthBiasEnable);
+            loadDeviceFunction(device, "vkCmdSetPrimitiveRestartEnableEXT", &this->vkCmdSetPrimitiveRestartEnable);
+            loadDeviceFunction(device, "vkCmdSetRasterizerDiscardEnableEXT", &this->vkCmdSetRasterizerDiscardEnable);
+        }
+
+        if (isEnabled(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+            if (extendedDynamicState3Features.extendedDynamicState3PolygonMode) {
+                loadDeviceFunction(device, "vkCmdSetPolygonModeEXT", &this->vkCmdSetPolygonMode);
+            }
+
+            if (extendedDynamicState3Features.extendedDynamicState3ColorBlendEnable) {
+                loadDeviceFunction(device, "vkCmdSetColorBlendEnableEXT", &this->vkCmdSetColorBlendEnable);
+            }
+
+            if (extendedDynamicState3Features.extendedDynamicState3ColorWriteMask) {
+                loadDeviceFunction(device, "vkCmdSetColorWriteMaskEXT", &this->vkCmdSetColorWriteMask);
+            }
+        }
+
+        if (isEnabled(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME)) {
+            loadDeviceFunction(device, "vkCreateDescriptorUpdateTemplateKHR", &this->vkCreateDescriptorUpdateTemplate);
+            loadDeviceFunction(device, "vkDestroyDescriptorUpdateTemplateKHR", &this->vkDestroyDescriptorUpdateTemplate);
+            loadDeviceFunction(device, "vkUpdateDescriptorSetWithTemplateKHR", &this->vkUpdateDescriptorSetWithTemplate);
+        }
+    }
+
+
+    bool DeviceFunctions::supportsDynamicState(VkDynamicState const dynamicState) const {
+        switch (dynamicState) {
+            case VK_DYNAMIC_STATE_VIEWPORT:
+            case VK_DYNAMIC_STATE_SCISSOR:
+            case VK_DYNAMIC_STATE_LINE_WIDTH:
+            case VK_DYNAMIC_STATE_DEPTH_BIAS:
+            case VK_DYNAMIC_STATE_BLEND_CONSTANTS:
+            case VK_DYNAMIC_STATE_DEPTH_BOUNDS:
+            case VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK:
+            case VK_DYNAMIC_STATE_STENCIL_WRITE_MASK:
+            case VK_DYNAMIC_STATE_STENCIL_REFERENCE:
+                return true;
+            case VK_DYNAMIC_STATE_CULL_MODE_EXT:
+                return this->vkCmdSetCullMode != nullptr;
+            case VK_DYNAMIC_STATE_FRONT_FACE_EXT:
+                return this->vkCmdSetFrontFace != nullptr;
+            case VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT:
+                return this->vkCmdSetPrimitiveTopology != nullptr;
+            case VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT:
+                return this->vkCmdSetDepthTestEnable != nullptr;
+            case VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT:
+                return this->vkCmdSetDepthWriteEnable != nullptr;
+            case VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT:
+                return this->vkCmdSetDepthCompareOp != nullptr;
+            case VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT:
+                return this->vkCmdSetDepthBiasEnable != nullptr;
+            case VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT:
+                return this->vkCmdSetPrimitiveRestartEnable != nullptr;
+            case VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE_EXT:
+                return this->vkCmdSetRasterizerDiscardEnable != nullptr;
+            case VK_DYNAMIC_STATE_POLYGON_MODE_EXT:
+                return this->vkCmdSetPolygonMode != nullptr;
+            case VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT:
+                return this->vkCmdSetColorBlendEnable != nullptr;
+            case VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT:
+                return this->vkCmdSetColorWriteMask != nullptr;
+            default:
+                return false;
+        }
+    }
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "vulkan/vulkan.h"
+
+#include <string>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Table of device level extension entry points.
+     * These are not exported by the loader, so we look them up once when the device is
+     * created. Pointers for extensions which were not enabled are left as nullptr.
+     */
+    struct DeviceFunctions {
+        // VK_KHR_draw_indirect_count
+        PFN_vkCmdDrawIndirectCountKHR vkCmdDrawIndirectCount = nullptr;
+        PFN_vkCmdDrawIndexedIndirectCountKHR vkCmdDrawIndexedIndirectCount = nullptr;
+
+        // VK_KHR_timeline_semaphore
+        PFN_vkGetSemaphoreCounterValueKHR vkGetSemaphoreCounterValue = nullptr;
+        PFN_vkWaitSemaphoresKHR vkWaitSemaphores = nullptr;
+        PFN_vkSignalSemaphoreKHR vkSignalSemaphore = nullptr;
+
+        // VK_EXT_extended_dynamic_state
+        PFN_vkCmdSetCullModeEXT vkCmdSetCullMode = nullptr;
+        PFN_vkCmdSetFrontFaceEXT vkCmdSetFrontFace = nullptr;
+        PFN_vkCmdSetPrimitiveTopologyEXT vkCmdSetPrimitiveTopology = nullptr;
+        PFN_vkCmdSetDepthTestEnableEXT vkCmdSetDepthTestEnable = nullptr;
+        PFN_vkCmdSetDepthWriteEnableEXT vkCmdSetDepthWriteEnable = nullptr;
+        PFN_vkCmdSetDepthCompareOpEXT vkCmdSetDepthCompareOp = nullptr;
+
+        // VK_EXT_extended_dynamic_state2
+        PFN_vkCmdSetDepthBiasEnableEXT vkCmdSetDepthBiasEnable = nullptr;
+        PFN_vkCmdSetPrimitiveRestartEnableEXT vkCmdSetPrimitiveRestartEnable = nullptr;
+        PFN_vkCmdSetRasterizerDiscardEnableEXT vkCmdSetRasterizerDiscardEnable = nullptr;
+
+        // VK_EXT_extended_dynamic_state3, each is only loaded if its feature is enabled
+        PFN_vkCmdSetPolygonModeEXT vkCmdSetPolygonMode = nullptr;
+        PFN_vkCmdSetColorBlendEnableEXT vkCmdSetColorBlendEnable = nullptr;
+        PFN_vkCmdSetColorWriteMaskEXT vkCmdSetColorWriteMask = nullptr;
+
+        // VK_KHR_descriptor_update_template
+        PFN_vkCreateDescriptorUpdateTemplateKHR vkCreateDescriptorUpdateTemplate = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR vkDestroyDescriptorUpdateTemplate = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR vkUpdateDescriptorSetWithTemplate = nullptr;
+
+        /**
+         * @brief Look up extension entry points for a device.
+         * @param device The device to load entry points for.
+         * @param enabledExtensions Names of the extensions enabled on the device.
+         * @param extendedDynamicState3Features Extended dynamic state 3 features enabled on the device.
+         */
+        void load(
+            VkDevice const device,
+            std::vector<std::string> const& enabledExtensions,
+            VkPhysicalDeviceExtendedDynamicState3FeaturesEXT const& extendedDynamicState3Features = {});
+
+        /**
+         * @brief Check whether a piece of pipeline state can be made dynamic on the device.
+         * @param dynamicState The dynamic state to check.
+         * @return True for core dynamic states and extension states whose setter is available.
+         */
+        bool supportsDynamicState(VkDynamicState const dynamicState) const;
+    };
+
+}
@@ -0,0 +1,18 @@
+#include "utils/vulkan/embedded_shader.hpp"
+
+#include <stdexcept>
+
+
+namespace utils::vulkan {
+
+    EmbeddedShader const& getEmbeddedShader(std::string const& name) {
+        for (auto const& shader : getEmbeddedShaders()) {
+            if (name == shader.name) {
+                return shader;
+            }
+        }
+
+        throw std::runtime_error("No embedded shader named '" + name + "'.");
+    }
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief SPIR-V code compiled into the binary at build time, see cmake/embed_shaders.cmake.
+     */
+    struct EmbeddedShader {
+        // Path of the shader relative to data/shaders, without extension, e.g. "triangle/vertex"
+        char const* name;
+
+        uint32_t const* code;
+        std::size_t size;
+
+        /**
+         * @brief Copy the SPIR-V words out of the binary.
+         */
+        std::vector<uint32_t> getCode() const {
+            return std::vector<uint32_t>(this->code, this->code + this->size);
+        }
+    };
+
+
+    /**
+     * @brief Get all shaders embedded in the binary.
+     * Defined in the source generated by the build.
+     */
+    std::vector<EmbeddedShader> const& getEmbeddedShaders();
+
+
+    /**
+     * @brief Look up an embedded shader by name.
+     * @param name Shader path relative to data/shaders, without extension.
+     * @return Reference to the embedded shader.
+     */
+    EmbeddedShader const& getEmbeddedShader(std::string const& name);
+
+}
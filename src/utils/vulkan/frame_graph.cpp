@@ -0,0 +1,486 @@
+#include "utils/vulkan/frame_graph.hpp"
+
+#include <algorithm>
+#include <map>
+
+
+namespace utils::vulkan {
+
+    utils::Logger FrameGraph::log("FrameGraph");
+
+
+    FrameGraphPass& FrameGraphPass::addAccess(FrameGraphAccess const& access) {
+        for (auto& existing : this->accesses) {
+            if (existing.resource != access.resource) {
+                continue;
+            }
+
+            if (existing.layout != access.layout) {
+                throw std::runtime_error("Unable to add access to pass '" + this->name + "', resource is already used in a different layout.");
+            }
+
+            existing.scope.stages |= access.scope.stages;
+            existing.scope.access |= access.scope.access;
+            existing.write = existing.write || access.write;
+            return *this;
+        }
+
+        this->accesses.push_back(access);
+        return *this;
+    }
+
+
+    FrameGraphPass& FrameGraphPass::readImage(uint32_t const resource, VkImageLayout const layout, AccessScope const& scope) {
+        return this->addAccess({resource, layout, scope, false});
+    }
+
+
+    FrameGraphPass& FrameGraphPass::writeImage(uint32_t const resource, VkImageLayout const layout, AccessScope const& scope) {
+        return this->addAccess({resource, layout, scope, true});
+    }
+
+
+    FrameGraphPass& FrameGraphPass::readBuffer(uint32_t const resource, AccessScope const& scope) {
+        return this->addAccess({resource, VK_IMAGE_LAYOUT_UNDEFINED, scope, false});
+    }
+
+
+    FrameGraphPass& FrameGraphPass::writeBuffer(uint32_t const resource, AccessScope const& scope) {
+        return this->addAccess({resource, VK_IMAGE_LAYOUT_UNDEFINED, scope, true});
+    }
+
+
+    FrameGraphPass& FrameGraphPass::writeColorAttachment(uint32_t const resource) {
+        return this->writeImage(
+            resource,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT});
+    }
+
+
+    FrameGraphPass& FrameGraphPass::writeDepthAttachment(uint32_t const resource) {
+        return this->writeImage(
+            resource,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT});
+    }
+
+
+    FrameGraphPass& FrameGraphPass::readSampledImage(uint32_t const resource, VkPipelineStageFlags const stages) {
+        return this->readImage(resource, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, {stages, VK_ACCESS_SHADER_READ_BIT});
+    }
+
+
+    FrameGraph::FrameGraph(
+        std::shared_ptr<Device> const& device,
+        std::shared_ptr<PhysicalDevice> const& physicalDevice
+    ) :
+        device(device),
+        physicalDevice(physicalDevice)
+    {
+        INFO(log) << "Creating frame graph." << std::endl;
+    }
+
+
+    uint32_t FrameGraph::addResource(Resource const& resource) {
+        if (this->compiled) {
+            throw std::runtime_error("Unable to add resource '" + resource.name + "', frame graph is already compiled.");
+        }
+
+        this->resources.push_back(resource);
+        return static_cast<uint32_t>(this->resources.size() - 1);
+    }
+
+
+    FrameGraph::Resource& FrameGraph::getResource(uint32_t const resource) {
+        if (resource >= this->resources.size()) {
+            throw std::runtime_error("Invalid frame graph resource index.");
+        }
+
+        return this->resources[resource];
+    }
+
+
+    uint32_t FrameGraph::createImage(std::string const& name, ImageConfig const& config) {
+        Resource resource;
+        resource.name = name;
+        resource.isImage = true;
+        resource.transient = true;
+        resource.imageConfig.emplace(config);
+        return this->addResource(resource);
+    }
+
+
+    uint32_t FrameGraph::createBuffer(std::string const& name, uint64_t const size, VkBufferUsageFlags const usage) {
+        Resource resource;
+        resource.name = name;
+        resource.isImage = false;
+        resource.transient = true;
+        resource.bufferSize = size;
+        resource.bufferUsage = usage;
+        return this->addResource(resource);
+    }
+
+
+    uint32_t FrameGraph::importImage(
+        std::string const& name,
+        bool const discardContents,
+        AccessScope const& availableScope
+    ) {
+        Resource resource;
+        resource.name = name;
+        resource.isImage = true;
+        resource.transient = false;
+        resource.discardOnFirstUse = discardContents;
+        resource.availableScope = availableScope;
+        return this->addResource(resource);
+    }
+
+
+    uint32_t FrameGraph::importBuffer(std::string const& name) {
+        Resource resource;
+        resource.name = name;
+        resource.isImage = false;
+        resource.transient = false;
+        return this->addResource(resource);
+    }
+
+
+    void FrameGraph::setImportedImage(uint32_t const resource, std::shared_ptr<Image> const& image) {
+        auto& importedResource = this->getResource(resource);
+
+        if (importedResource.transient || !importedResource.isImage) {
+            throw std::runtime_error("Unable to set image for resource '" + importedResource.name + "', it is not an imported image.");
+        }
+
+        importedResource.image = image;
+    }
+
+
+    void FrameGraph::setImportedBuffer(uint32_t const resource, std::shared_ptr<Buffer> const& buffer) {
+        auto& importedResource = this->getResource(resource);
+
+        if (importedResource.transient || importedResource.isImage) {
+            throw std::runtime_error("Unable to set buffer for resource '" + importedResource.name + "', it is not an imported buffer.");
+        }
+
+        importedResource.buffer = buffer;
+    }
+
+
+    FrameGraphPass& FrameGraph::addPass(std::string const& name) {
+        if (this->compiled) {
+            throw std::runtime_error("Unable to add pass '" + name + "', frame graph is already compiled.");
+        }
+
+        this->passes.push_back(std::make_shared<FrameGraphPass>(name));
+        return *this->passes.back();
+    }
+
+
+    void FrameGraph::markOutput(uint32_t const resource) {
+        this->getResource(resource).output = true;
+    }
+
+
+    void FrameGraph::markOutput(uint32_t const resource, VkImageLayout const finalLayout, AccessScope const& finalScope) {
+        auto& outputResource = this->getResource(resource);
+
+        if (!outputResource.isImage) {
+            throw std::runtime_error("Unable to set final layout of resource '" + outputResource.name + "', it is not an image.");
+        }
+
+        outputResource.output = true;
+        outputResource.finalLayout = finalLayout;
+        outputResource.finalScope = finalScope;
+    }
+
+
+    void FrameGraph::cullPasses() {
+        std::vector<bool> needed(this->resources.size(), false);
+        std::vector<bool> live(this->passes.size(), false);
+
+        for (unsigned i = 0; i < this->resources.size(); i++) {
+            needed[i] = this->resources[i].output;
+        }
+
+        // Passes are in submission order, so walking backwards visits consumers before producers.
+        // Only reads keep earlier producers alive, a pass which preserves earlier contents of a
+        // resource it writes (e.g. with VK_ATTACHMENT_LOAD_OP_LOAD) must also declare a read.
+        for (unsigned i = static_cast<unsigned>(this->passes.size()); i-- > 0;) {
+            auto const& pass = this->passes[i];
+            bool contributes = pass->sideEffects;
+
+            for (auto const& access : pass->accesses) {
+                if (access.write && needed[access.resource]) {
+                    contributes = true;
+                }
+            }
+
+            if (!contributes) {
+                INFO(log) << "Culling pass '" << pass->name << "', it does not contribute to any output." << std::endl;
+                continue;
+            }
+
+            live[i] = true;
+
+            for (auto const& access : pass->accesses) {
+                if (!access.write) {
+                    needed[access.resource] = true;
+                }
+            }
+        }
+
+        this->livePasses.clear();
+
+        for (unsigned i = 0; i < this->passes.size(); i++) {
+            if (live[i]) {
+                this->livePasses.push_back(i);
+            }
+        }
+    }
+
+
+    void FrameGraph::allocateTransientResources() {
+        struct Placement {
+            uint32_t resource;
+            uint32_t memoryType;
+            uint64_t alignment;
+            uint64_t size;
+            uint64_t offset;
+        };
+
+        std::vector<Placement> placements;
+        uint64_t const granularity = this->physicalDevice->getProperties().limits.bufferImageGranularity;
+
+        for (uint32_t i = 0; i < this->resources.size(); i++) {
+            auto& resource = this->resources[i];
+
+            if (!resource.transient || !resource.firstUse.has_value()) {
+                continue;
+            }
+
+            VkMemoryRequirements requirements {};
+
+            if (resource.isImage) {
+                resource.image = this->device->createImage(*resource.imageConfig);
+                requirements = resource.image->getMemoryRequirements();
+            } else {
+                resource.buffer = this->device->createBuffer(resource.bufferSize, resource.bufferUsage, VK_SHARING_MODE_EXCLUSIVE);
+                requirements = resource.buffer->getMemoryRequirements();
+            }
+
+            Placement placement {};
+            placement.resource = i;
+            placement.memoryType = this->physicalDevice->selectMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            placement.alignment = std::max(requirements.alignment, granularity);
+            placement.size = requirements.size;
+            placements.push_back(placement);
+        }
+
+        // Place the largest resources first, it gives the smaller ones more holes to fit into
+        std::stable_sort(placements.begin(), placements.end(), [](Placement const& a, Placement const& b) {
+            return a.size > b.size;
+        });
+
+        auto const lifetimesOverlap = [&](Placement const& a, Placement const& b) {
+            auto const& resourceA = this->resources[a.resource];
+            auto const& resourceB = this->resources[b.resource];
+            return *resourceA.firstUse <= *resourceB.lastUse && *resourceB.firstUse <= *resourceA.lastUse;
+        };
+
+        auto const memoryOverlaps = [](Placement const& a, Placement const& b) {
+            return a.memoryType == b.memoryType && a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+        };
+
+        std::map<uint32_t, uint64_t> blockSizes;
+        uint64_t unaliasedSize = 0;
+
+        for (unsigned i = 0; i < placements.size(); i++) {
+            auto& placement = placements[i];
+
+            // Candidate offsets are the start of the block and the end of every placed resource
+            std::vector<uint64_t> candidates = {0};
+            for (unsigned j = 0; j < i; j++) {
+                if (placements[j].memoryType == placement.memoryType) {
+                    uint64_t const end = placements[j].offset + placements[j].size;
+                    candidates.push_back((end + placement.alignment - 1) / placement.alignment * placement.alignment);
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end());
+
+            for (auto const candidate : candidates) {
+                placement.offset = candidate;
+                bool fits = true;
+
+                for (unsigned j = 0; j < i && fits; j++) {
+                    fits = !lifetimesOverlap(placement, placements[j]) || !memoryOverlaps(placement, placements[j]);
+                }
+
+                if (fits) {
+                    break;
+                }
+            }
+
+            auto& blockSize = blockSizes[placement.memoryType];
+            blockSize = std::max(blockSize, placement.offset + placement.size);
+            unaliasedSize += placement.size;
+        }
+
+        // One allocation per memory type, shared by every transient resource of that type
+        std::map<uint32_t, std::shared_ptr<DeviceMemory>> blocks;
+        uint64_t aliasedSize = 0;
+
+        for (auto const& [memoryType, blockSize] : blockSizes) {
+            blocks[memoryType] = this->device->allocateDeviceMemory(memoryType, blockSize);
+            this->transientMemory.push_back(blocks[memoryType]);
+            aliasedSize += blockSize;
+        }
+
+        for (auto const& placement : placements) {
+            auto& resource = this->resources[placement.resource];
+
+            if (resource.isImage) {
+                resource.image->bindMemory(blocks[placement.memoryType], placement.offset);
+            } else {
+                resource.buffer->bindMemory(blocks[placement.memoryType], placement.offset);
+            }
+
+            for (auto const& other : placements) {
+                if (other.resource != placement.resource && memoryOverlaps(placement, other)) {
+                    resource.aliases.push_back(other.resource);
+                }
+            }
+        }
+
+        INFO(log) << "Allocated " << aliasedSize << " bytes for " << placements.size()
+                  << " transient resources (" << unaliasedSize << " bytes without aliasing)." << std::endl;
+    }
+
+
+    void FrameGraph::compile() {
+        if (this->compiled) {
+            throw std::runtime_error("Unable to compile frame graph, it is already compiled.");
+        }
+
+        this->cullPasses();
+
+        for (uint32_t position = 0; position < this->livePasses.size(); position++) {
+            auto const& pass = this->passes[this->livePasses[position]];
+
+            for (auto const& access : pass->accesses) {
+                auto& resource = this->getResource(access.resource);
+
+                if (resource.isImage && access.layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+                    throw std::runtime_error("Pass '" + pass->name + "' uses image '" + resource.name + "' without a layout.");
+                }
+
+                if (!resource.firstUse.has_value()) {
+                    if (resource.transient && !access.write) {
+                        throw std::runtime_error("Pass '" + pass->name + "' reads transient resource '" + resource.name + "' before it is written.");
+                    }
+
+                    resource.firstUse = position;
+                }
+
+                resource.lastUse = position;
+            }
+        }
+
+        // Outputs stay alive until the end of the graph
+        for (auto& resource : this->resources) {
+            if (resource.output && resource.firstUse.has_value()) {
+                resource.lastUse = static_cast<uint32_t>(this->livePasses.size());
+            }
+        }
+
+        this->allocateTransientResources();
+        this->compiled = true;
+
+        INFO(log) << "Compiled frame graph, " << this->livePasses.size() << " of " << this->passes.size() << " passes are live." << std::endl;
+    }
+
+
+    void FrameGraph::execute(std::shared_ptr<CommandBuffer> const& commandBuffer) {
+        if (!this->compiled) {
+            throw std::runtime_error("Unable to execute frame graph, it has not been compiled.");
+        }
+
+        for (uint32_t position = 0; position < this->livePasses.size(); position++) {
+            auto const& pass = this->passes[this->livePasses[position]];
+
+            for (auto const& access : pass->accesses) {
+                auto const& resource = this->resources[access.resource];
+
+                if (resource.isImage ? resource.image == nullptr : resource.buffer == nullptr) {
+                    throw std::runtime_error("Unable to execute pass '" + pass->name + "', resource '" + resource.name + "' is not set.");
+                }
+
+                if (*resource.firstUse == position) {
+                    ResourceState priorState;
+
+                    if (resource.transient) {
+                        // Memory may have been used by aliased resources, the first use must wait on them
+                        for (uint32_t const alias : resource.aliases) {
+                            auto const& aliased = this->resources[alias];
+                            priorState |= aliased.isImage ? aliased.image->getCombinedState() : aliased.buffer->getCombinedState();
+                        }
+
+                        priorState |= resource.isImage ? resource.image->getCombinedState() : resource.buffer->getCombinedState();
+                    } else {
+                        priorState.lastWrite = resource.availableScope;
+                    }
+
+                    if (resource.transient || resource.discardOnFirstUse) {
+                        if (resource.isImage) {
+                            resource.image->discardContents(priorState);
+                        } else {
+                            resource.buffer->discardContents(priorState);
+                        }
+                    }
+                }
+
+                if (resource.isImage) {
+                    commandBuffer->useImage(resource.image, access.layout, access.scope);
+                } else {
+                    commandBuffer->useBuffer(resource.buffer, access.scope);
+                }
+            }
+
+            commandBuffer->flushBarriers();
+
+            if (pass->recordFunction) {
+                pass->recordFunction(commandBuffer);
+            }
+        }
+
+        for (auto const& resource : this->resources) {
+            if (resource.output && resource.isImage && resource.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED && resource.image != nullptr) {
+                commandBuffer->useImage(resource.image, resource.finalLayout, resource.finalScope);
+            }
+        }
+
+        commandBuffer->flushBarriers();
+    }
+
+
+    std::shared_ptr<Image> FrameGraph::getImage(uint32_t const resource) const {
+        if (resource >= this->resources.size() || !this->resources[resource].isImage) {
+            throw std::runtime_error("Frame graph resource is not an image.");
+        }
+
+        return this->resources[resource].image;
+    }
+
+
+    std::shared_ptr<Buffer> FrameGraph::getBuffer(uint32_t const resource) const {
+        if (resource >= this->resources.size() || this->resources[resource].isImage) {
+            throw std::runtime_error("Frame graph resource is not a buffer.");
+        }
+
+        return this->resources[resource].buffer;
+    }
+
+}
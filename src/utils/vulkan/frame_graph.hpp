@@ -0,0 +1,301 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/device.hpp"
+#include "utils/vulkan/physical_device.hpp"
+#include "utils/vulkan/command_buffer.hpp"
+#include "utils/vulkan/resource_state.hpp"
+
+#include "vulkan/vulkan.h"
+
+#include <functional>
+#include <optional>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief A single use of a frame graph resource by a pass.
+     */
+    struct FrameGraphAccess {
+        uint32_t resource;
+        VkImageLayout layout;
+        AccessScope scope;
+        bool write;
+    };
+
+
+    /**
+     * @brief Helper object for declaring the resources a frame graph pass uses.
+     * Each resource may be used in only one layout per pass, repeated uses are merged.
+     */
+    class FrameGraphPass {
+        friend class FrameGraph;
+
+    private:
+        std::string const name;
+
+        std::vector<FrameGraphAccess> accesses;
+
+        std::function<void(std::shared_ptr<CommandBuffer> const&)> recordFunction;
+
+        bool sideEffects = false;
+
+        /**
+         * @brief Add an access, merging it with any existing access to the same resource.
+         */
+        FrameGraphPass& addAccess(FrameGraphAccess const& access);
+
+    public:
+        FrameGraphPass(std::string const& name) : name(name) {}
+
+        /**
+         * @brief Declare that the pass reads an image.
+         * @param resource Frame graph resource index of the image.
+         * @param layout Layout the image must be in during the pass.
+         * @param scope Stages and accesses the pass reads the image with.
+         */
+        FrameGraphPass& readImage(uint32_t const resource, VkImageLayout const layout, AccessScope const& scope);
+
+        /**
+         * @brief Declare that the pass writes an image.
+         * @param resource Frame graph resource index of the image.
+         * @param layout Layout the image must be in during the pass.
+         * @param scope Stages and accesses the pass writes the image with.
+         */
+        FrameGraphPass& writeImage(uint32_t const resource, VkImageLayout const layout, AccessScope const& scope);
+
+        /**
+         * @brief Declare that the pass reads a buffer.
+         * @param resource Frame graph resource index of the buffer.
+         * @param scope Stages and accesses the pass reads the buffer with.
+         */
+        FrameGraphPass& readBuffer(uint32_t const resource, AccessScope const& scope);
+
+        /**
+         * @brief Declare that the pass writes a buffer.
+         * @param resource Frame graph resource index of the buffer.
+         * @param scope Stages and accesses the pass writes the buffer with.
+         */
+        FrameGraphPass& writeBuffer(uint32_t const resource, AccessScope const& scope);
+
+        /**
+         * @brief Declare that the pass renders to an image as a color attachment.
+         * @param resource Frame graph resource index of the image.
+         */
+        FrameGraphPass& writeColorAttachment(uint32_t const resource);
+
+        /**
+         * @brief Declare that the pass renders to an image as a depth/stencil attachment.
+         * @param resource Frame graph resource index of the image.
+         */
+        FrameGraphPass& writeDepthAttachment(uint32_t const resource);
+
+        /**
+         * @brief Declare that the pass samples an image from shaders.
+         * @param resource Frame graph resource index of the image.
+         * @param stages Shader stages which sample the image.
+         */
+        FrameGraphPass& readSampledImage(
+            uint32_t const resource,
+            VkPipelineStageFlags const stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+        /**
+         * @brief Mark the pass as having effects outside the graph, so that it is never culled.
+         */
+        FrameGraphPass& setSideEffects() {
+            this->sideEffects = true;
+            return *this;
+        }
+
+        /**
+         * @brief Set the function which records the pass.
+         * Barriers for the declared resources are recorded before it is called. Render passes
+         * begun by the function should use the declared layouts as their initial and final layouts.
+         * @param function Function to call with the command buffer being recorded.
+         */
+        FrameGraphPass& setRecordFunction(std::function<void(std::shared_ptr<CommandBuffer> const&)> const& function) {
+            this->recordFunction = function;
+            return *this;
+        }
+    };
+
+
+    /**
+     * @brief Schedules passes, inserts the barriers between them and allocates transient resources.
+     *
+     * Passes are declared in submission order and execute in that order, so a pass may only
+     * read what earlier passes have written. Passes which contribute nothing to an output
+     * (and have no side effects) are culled when the graph is compiled. Transient resources
+     * whose lifetimes do not overlap share device memory.
+     *
+     * The graph is compiled once and executed every frame. Imported resources, such as swap
+     * chain images, can be swapped between executions without recompiling.
+     */
+    class FrameGraph {
+    private:
+        static utils::Logger log;
+
+        struct Resource {
+            std::string name;
+            bool isImage;
+            bool transient;
+
+            // Transient resource descriptions
+            std::optional<ImageConfig> imageConfig;
+            uint64_t bufferSize = 0;
+            VkBufferUsageFlags bufferUsage = 0;
+
+            // Imported resources may have their contents discarded on first use
+            bool discardOnFirstUse = false;
+            AccessScope availableScope;
+
+            std::shared_ptr<Image> image;
+            std::shared_ptr<Buffer> buffer;
+
+            // Outputs keep their producers alive, and may be transitioned after the last pass
+            bool output = false;
+            VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            AccessScope finalScope;
+
+            // Compiled state, indices into the live pass list
+            std::optional<uint32_t> firstUse;
+            std::optional<uint32_t> lastUse;
+            std::vector<uint32_t> aliases;
+        };
+
+        std::shared_ptr<Device> const device;
+        std::shared_ptr<PhysicalDevice> const physicalDevice;
+
+        std::vector<Resource> resources;
+        std::vector<std::shared_ptr<FrameGraphPass>> passes;
+
+        std::vector<uint32_t> livePasses;
+        std::vector<std::shared_ptr<DeviceMemory>> transientMemory;
+
+        bool compiled = false;
+
+    private:
+        uint32_t addResource(Resource const& resource);
+
+        Resource& getResource(uint32_t const resource);
+
+        /**
+         * @brief Walk passes backwards from the outputs, keeping only those which contribute.
+         */
+        void cullPasses();
+
+        /**
+         * @brief Create transient resources and bind them to shared memory blocks.
+         */
+        void allocateTransientResources();
+
+    public:
+        /**
+         * @brief Construct an empty frame graph.
+         * @param device Shared pointer to the device to create transient resources on.
+         * @param physicalDevice Shared pointer to the physical device, used to select memory types.
+         */
+        FrameGraph(std::shared_ptr<Device> const& device, std::shared_ptr<PhysicalDevice> const& physicalDevice);
+
+        /**
+         * @brief Declare a transient image owned by the graph.
+         * @param name Name of the image, used in log messages.
+         * @param config Configuration of the image to create.
+         * @return Frame graph resource index of the image.
+         */
+        uint32_t createImage(std::string const& name, ImageConfig const& config);
+
+        /**
+         * @brief Declare a transient buffer owned by the graph.
+         * @param name Name of the buffer, used in log messages.
+         * @param size Size of the buffer in bytes.
+         * @param usage Usage flags of the buffer.
+         * @return Frame graph resource index of the buffer.
+         */
+        uint32_t createBuffer(std::string const& name, uint64_t const size, VkBufferUsageFlags const usage);
+
+        /**
+         * @brief Declare an image owned outside the graph.
+         * @param name Name of the image, used in log messages.
+         * @param discardContents If true, contents are discarded before the first use each execution.
+         * @param availableScope Scope the first use must wait on when contents are discarded,
+         * e.g. the stage at which the swap chain acquire semaphore is waited on.
+         * @return Frame graph resource index of the image.
+         */
+        uint32_t importImage(
+            std::string const& name,
+            bool const discardContents = false,
+            AccessScope const& availableScope = AccessScope());
+
+        /**
+         * @brief Declare a buffer owned outside the graph.
+         * @param name Name of the buffer, used in log messages.
+         * @return Frame graph resource index of the buffer.
+         */
+        uint32_t importBuffer(std::string const& name);
+
+        /**
+         * @brief Set the image backing an imported image resource.
+         * @param resource Frame graph resource index of the imported image.
+         * @param image Shared pointer to the image.
+         */
+        void setImportedImage(uint32_t const resource, std::shared_ptr<Image> const& image);
+
+        /**
+         * @brief Set the buffer backing an imported buffer resource.
+         * @param resource Frame graph resource index of the imported buffer.
+         * @param buffer Shared pointer to the buffer.
+         */
+        void setImportedBuffer(uint32_t const resource, std::shared_ptr<Buffer> const& buffer);
+
+        /**
+         * @brief Add a pass to the end of the graph.
+         * @param name Name of the pass, used in log messages.
+         * @return Reference to the pass, for declaring its resources.
+         */
+        FrameGraphPass& addPass(std::string const& name);
+
+        /**
+         * @brief Mark a resource as an output of the graph.
+         * @param resource Frame graph resource index.
+         */
+        void markOutput(uint32_t const resource);
+
+        /**
+         * @brief Mark an image as an output of the graph, transitioning it after the last pass.
+         * @param resource Frame graph resource index of the image.
+         * @param finalLayout Layout to leave the image in (e.g. VK_IMAGE_LAYOUT_PRESENT_SRC_KHR).
+         * @param finalScope Stages and accesses of the image's next use.
+         */
+        void markOutput(uint32_t const resource, VkImageLayout const finalLayout, AccessScope const& finalScope);
+
+        /**
+         * @brief Cull unused passes, validate resource use and allocate transient resources.
+         * Must be called after all passes are added and before execute.
+         */
+        void compile();
+
+        /**
+         * @brief Record every live pass, with barriers, into a command buffer.
+         * @param commandBuffer Shared pointer to a command buffer in the recording state.
+         */
+        void execute(std::shared_ptr<CommandBuffer> const& commandBuffer);
+
+        /**
+         * @brief Get the image backing a resource, for use in record functions.
+         * @param resource Frame graph resource index of the image.
+         */
+        std::shared_ptr<Image> getImage(uint32_t const resource) const;
+
+        /**
+         * @brief Get the buffer backing a resource, for use in record functions.
+         * @param resource Frame graph resource index of the buffer.
+         */
+        std::shared_ptr<Buffer> getBuffer(uint32_t const resource) const;
+    };
+
+}
@@ -1,142 +1,526 @@
 #include "utils/vulkan/graphics_pipeline.hpp"
+#include "utils/misc/hash.hpp"
+
+#include <cstring>
 
 
 namespace utils::vulkan {
 
     utils::Logger GraphicsPipeline::log("GraphicsPipeline");
+    utils::Logger GraphicsPipelineLibrary::log("GraphicsPipelineLibrary");
+
+
+    /**
+     * @brief Fixed function state for a graphics pipeline, built from a config.
+     * Holds pointers into itself and the config, so it is neither copyable nor movable.
+     */
+    struct GraphicsPipelineState {
+        std::vector<VkSpecializationInfo> specializationInfos;
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+        VkPipelineVertexInputStateCreateInfo vertexInput {};
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
+        VkPipelineDynamicStateCreateInfo dynamicState {};
+        VkPipelineViewportStateCreateInfo viewportState {};
+        VkPipelineRasterizationStateCreateInfo rasterizer {};
+        VkPipelineMultisampleStateCreateInfo multisampling {};
+        VkPipelineDepthStencilStateCreateInfo depthStencil {};
+        VkPipelineColorBlendAttachmentState colorBlendAttachment {};
+        VkPipelineColorBlendStateCreateInfo colorBlending {};
+
+        GraphicsPipelineState(GraphicsPipelineConfig const& config) :
+            specializationInfos(config.shaderStages.size())
+        {
+            for (unsigned i = 0; i < config.shaderStages.size(); i++) {
+                this->shaderStages.push_back(config.shaderStages[i].toVulkan(this->specializationInfos[i]));
+            }
+
+            vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+            vertexInput.vertexBindingDescriptionCount = static_cast<uint32_t>(config.vertexInfo.vertexTypes.size());
+            vertexInput.pVertexBindingDescriptions = config.vertexInfo.vertexTypes.data();
+            vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(config.vertexInfo.attributes.size());
+            vertexInput.pVertexAttributeDescriptions = config.vertexInfo.attributes.data();
+
+            inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+            inputAssembly.topology = config.topology;
+            inputAssembly.primitiveRestartEnable = config.primitiveRestartEnable;
+
+            dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+            dynamicState.dynamicStateCount = static_cast<uint32_t>(config.dynamicStates.size());
+            dynamicState.pDynamicStates = config.dynamicStates.data();
+
+            // Viewport and scissor are always dynamic
+            viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+            viewportState.viewportCount = 1;
+            viewportState.scissorCount = 1;
+
+            rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+            rasterizer.depthClampEnable = VK_FALSE;
+            rasterizer.rasterizerDiscardEnable = config.rasterizerDiscardEnable;
+            rasterizer.polygonMode = config.polygonMode;
+            rasterizer.lineWidth = 1.0f;
+            rasterizer.cullMode = config.cullMode;
+            rasterizer.frontFace = config.frontFace;
+            rasterizer.depthBiasEnable = config.depthBiasEnable;
+            rasterizer.depthBiasConstantFactor = 0.0f;          // Optional
+            rasterizer.depthBiasClamp = 0.0f;                   // Optional
+            rasterizer.depthBiasSlopeFactor = 0.0f;             // Optional
+
+            // TODO - Add to config
+            multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+            multisampling.sampleShadingEnable = VK_FALSE;
+            multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+            multisampling.minSampleShading = 1.0f;              // Optional
+            multisampling.pSampleMask = nullptr;                // Optional
+            multisampling.alphaToCoverageEnable = VK_FALSE;     // Optional
+            multisampling.alphaToOneEnable = VK_FALSE;          // Optional
+
+            depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+            depthStencil.depthTestEnable = config.depthTestEnable;
+            depthStencil.depthWriteEnable = config.depthWriteEnable;
+            depthStencil.depthCompareOp = config.depthCompareOp;
+            depthStencil.depthBoundsTestEnable = VK_FALSE;
+            depthStencil.stencilTestEnable = VK_FALSE;
+
+            colorBlendAttachment.colorWriteMask = config.colorWriteMask;
+            colorBlendAttachment.blendEnable = config.blendEnable;
+            colorBlendAttachment.srcColorBlendFactor = config.srcColorBlendFactor;
+            colorBlendAttachment.dstColorBlendFactor = config.dstColorBlendFactor;
+            colorBlendAttachment.colorBlendOp = config.colorBlendOp;
+            colorBlendAttachment.srcAlphaBlendFactor = config.srcAlphaBlendFactor;
+            colorBlendAttachment.dstAlphaBlendFactor = config.dstAlphaBlendFactor;
+            colorBlendAttachment.alphaBlendOp = config.alphaBlendOp;
+
+            // TODO - Add to config
+            colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+            colorBlending.logicOpEnable = VK_FALSE;
+            colorBlending.logicOp = VK_LOGIC_OP_COPY;           // Optional
+            colorBlending.attachmentCount = 1;
+            colorBlending.pAttachments = &colorBlendAttachment;
+            colorBlending.blendConstants[0] = 0.0f;             // Optional
+            colorBlending.blendConstants[1] = 0.0f;             // Optional
+            colorBlending.blendConstants[2] = 0.0f;             // Optional
+            colorBlending.blendConstants[3] = 0.0f;             // Optional
+        }
+
+        GraphicsPipelineState(GraphicsPipelineState const&) = delete;
+        GraphicsPipelineState& operator=(GraphicsPipelineState const&) = delete;
+    };
+
+
+    bool VertexInfo::operator==(VertexInfo const& other) const {
+        if (this->vertexTypes.size() != other.vertexTypes.size() || this->attributes.size() != other.attributes.size()) {
+            return false;
+        }
+
+        for (unsigned i = 0; i < this->vertexTypes.size(); i++) {
+            auto const& a = this->vertexTypes[i];
+            auto const& b = other.vertexTypes[i];
+
+            if (a.binding != b.binding || a.stride != b.stride || a.inputRate != b.inputRate) {
+                return false;
+            }
+        }
+
+        for (unsigned i = 0; i < this->attributes.size(); i++) {
+            auto const& a = this->attributes[i];
+            auto const& b = other.attributes[i];
+
+            if (a.location != b.location || a.binding != b.binding || a.format != b.format || a.offset != b.offset) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    std::size_t VertexInfo::hash() const {
+        std::size_t seed = 0;
+
+        for (auto const& vertexType : this->vertexTypes) {
+            utils::hashCombine(seed, vertexType.binding);
+            utils::hashCombine(seed, vertexType.stride);
+            utils::hashCombine(seed, static_cast<uint32_t>(vertexType.inputRate));
+        }
+
+        for (auto const& attribute : this->attributes) {
+            utils::hashCombine(seed, attribute.location);
+            utils::hashCombine(seed, attribute.binding);
+            utils::hashCombine(seed, static_cast<uint32_t>(attribute.format));
+            utils::hashCombine(seed, attribute.offset);
+        }
+
+        return seed;
+    }
+
+
+    void ShaderStageConfig::setSpecializationData(
+        uint32_t const constantId,
+        void const * const data,
+        std::size_t const size
+    ) {
+        for (auto const& entry : this->specializationEntries) {
+            if (entry.constantID == constantId) {
+                if (entry.size != size) {
+                    throw std::runtime_error("Failed to set specialization constant: Size differs from previous value.");
+                }
+
+                std::memcpy(this->specializationData.data() + entry.offset, data, size);
+                return;
+            }
+        }
+
+        VkSpecializationMapEntry entry {};
+        entry.constantID = constantId;
+        entry.offset = static_cast<uint32_t>(this->specializationData.size());
+        entry.size = size;
+
+        this->specializationEntries.push_back(entry);
+
+        auto const bytes = static_cast<uint8_t const *>(data);
+        this->specializationData.insert(this->specializationData.end(), bytes, bytes + size);
+    }
+
+
+    bool ShaderStageConfig::operator==(ShaderStageConfig const& other) const {
+        if (
+            this->shaderModule != other.shaderModule ||
+            this->flagBits != other.flagBits ||
+            this->shaderMain != other.shaderMain ||
+            this->specializationData != other.specializationData ||
+            this->specializationEntries.size() != other.specializationEntries.size()
+        ) {
+            return false;
+        }
+
+        for (unsigned i = 0; i < this->specializationEntries.size(); i++) {
+            auto const& a = this->specializationEntries[i];
+            auto const& b = other.specializationEntries[i];
+
+            if (a.constantID != b.constantID || a.offset != b.offset || a.size != b.size) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    std::size_t ShaderStageConfig::hash() const {
+        std::size_t seed = 0;
+        utils::hashCombine(seed, this->shaderModule.get());
+        utils::hashCombine(seed, static_cast<uint32_t>(this->flagBits));
+        utils::hashCombine(seed, this->shaderMain);
+
+        for (auto const& entry : this->specializationEntries) {
+            utils::hashCombine(seed, entry.constantID);
+            utils::hashCombine(seed, entry.offset);
+        }
+
+        for (auto const byte : this->specializationData) {
+            utils::hashCombine(seed, byte);
+        }
+
+        return seed;
+    }
+
+
+    GraphicsPipelineConfig GraphicsPipelineConfig::resolveDynamicStates(DeviceFunctions const& functions) const {
+        GraphicsPipelineConfig resolved = *this;
+
+        resolved.dynamicStates.erase(
+            std::remove_if(resolved.dynamicStates.begin(), resolved.dynamicStates.end(), [&](VkDynamicState const state) {
+                return !functions.supportsDynamicState(state);
+            }),
+            resolved.dynamicStates.end());
+
+        return resolved;
+    }
+
+
+    bool GraphicsPipelineConfig::operator==(GraphicsPipelineConfig const& other) const {
+        if (this->shaderStages != other.shaderStages || this->vertexInfo != other.vertexInfo) {
+            return false;
+        }
+
+        // Dynamic state sets are compared in order, callers are expected to build configs consistently
+        if (this->dynamicStates != other.dynamicStates) {
+            return false;
+        }
+
+        auto const same = [&](VkDynamicState const state, auto const& a, auto const& b) {
+            return this->isDynamic(state) || a == b;
+        };
+
+        return
+            same(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT, this->topology, other.topology) &&
+            same(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT, this->primitiveRestartEnable, other.primitiveRestartEnable) &&
+            same(VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE_EXT, this->rasterizerDiscardEnable, other.rasterizerDiscardEnable) &&
+            same(VK_DYNAMIC_STATE_POLYGON_MODE_EXT, this->polygonMode, other.polygonMode) &&
+            same(VK_DYNAMIC_STATE_CULL_MODE_EXT, this->cullMode, other.cullMode) &&
+            same(VK_DYNAMIC_STATE_FRONT_FACE_EXT, this->frontFace, other.frontFace) &&
+            same(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT, this->depthBiasEnable, other.depthBiasEnable) &&
+            same(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT, this->depthTestEnable, other.depthTestEnable) &&
+            same(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT, this->depthWriteEnable, other.depthWriteEnable) &&
+            same(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT, this->depthCompareOp, other.depthCompareOp) &&
+            same(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT, this->blendEnable, other.blendEnable) &&
+            same(VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT, this->colorWriteMask, other.colorWriteMask) &&
+            this->srcColorBlendFactor == other.srcColorBlendFactor &&
+            this->dstColorBlendFactor == other.dstColorBlendFactor &&
+            this->colorBlendOp == other.colorBlendOp &&
+            this->srcAlphaBlendFactor == other.srcAlphaBlendFactor &&
+            this->dstAlphaBlendFactor == other.dstAlphaBlendFactor &&
+            this->alphaBlendOp == other.alphaBlendOp;
+    }
+
+
+    std::size_t GraphicsPipelineConfig::hash() const {
+        std::size_t seed = 0;
+
+        for (auto const& shaderStage : this->shaderStages) {
+            utils::hashCombine(seed, shaderStage.hash());
+        }
+
+        utils::hashCombine(seed, this->vertexInfo.hash());
+
+        for (auto const state : this->dynamicStates) {
+            utils::hashCombine(seed, static_cast<uint32_t>(state));
+        }
+
+        // Must skip exactly the state operator== ignores
+        auto const mix = [&](VkDynamicState const state, uint32_t const value) {
+            if (!this->isDynamic(state)) {
+                utils::hashCombine(seed, value);
+            }
+        };
+
+        mix(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT, this->topology);
+        mix(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT, this->primitiveRestartEnable);
+        mix(VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE_EXT, this->rasterizerDiscardEnable);
+        mix(VK_DYNAMIC_STATE_POLYGON_MODE_EXT, this->polygonMode);
+        mix(VK_DYNAMIC_STATE_CULL_MODE_EXT, this->cullMode);
+        mix(VK_DYNAMIC_STATE_FRONT_FACE_EXT, this->frontFace);
+        mix(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT, this->depthBiasEnable);
+        mix(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT, this->depthTestEnable);
+        mix(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT, this->depthWriteEnable);
+        mix(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT, this->depthCompareOp);
+        mix(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT, this->blendEnable);
+        mix(VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT, this->colorWriteMask);
+
+        utils::hashCombine(seed, static_cast<uint32_t>(this->srcColorBlendFactor));
+        utils::hashCombine(seed, static_cast<uint32_t>(this->dstColorBlendFactor));
+        utils::hashCombine(seed, static_cast<uint32_t>(this->colorBlendOp));
+        utils::hashCombine(seed, static_cast<uint32_t>(this->srcAlphaBlendFactor));
+        utils::hashCombine(seed, static_cast<uint32_t>(this->dstAlphaBlendFactor));
+        utils::hashCombine(seed, static_cast<uint32_t>(this->alphaBlendOp));
+
+        return seed;
+    }
 
 
     GraphicsPipeline::GraphicsPipeline(
         std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
         std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
         std::shared_ptr<RenderPassHandle> const& vkRenderPassHandle,
         GraphicsPipelineConfig const& config
     ) :
         HandleWrapper<PipelineHandle>(std::make_shared<PipelineHandle>(vkDeviceHandle)),
         vkDeviceHandle(vkDeviceHandle),
+        vkPipelineCacheHandle(vkPipelineCacheHandle),
         vkPipelineLayoutHandle(vkPipelineLayoutHandle),
         vkRenderPassHandle(vkRenderPassHandle),
-        config(config)
+        config(config.resolveDynamicStates(vkDeviceHandle->functions)),
+        fastLinked(false)
     {
         INFO(log) << "Creating new graphics pipeline." << std::endl;
 
-        VkPipelineShaderStageCreateInfo shaderStages[config.shaderStages.size()];
-        for (unsigned i = 0; i < config.shaderStages.size(); i++) {
-            shaderStages[i] = config.shaderStages[i].toVulkan();
+        GraphicsPipelineState const state(this->config);
+
+        VkGraphicsPipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount = static_cast<uint32_t>(state.shaderStages.size());
+        pipelineInfo.pStages = state.shaderStages.data();
+        pipelineInfo.pVertexInputState = &state.vertexInput;
+        pipelineInfo.pInputAssemblyState = &state.inputAssembly;
+        pipelineInfo.pViewportState = &state.viewportState;
+        pipelineInfo.pRasterizationState = &state.rasterizer;
+        pipelineInfo.pMultisampleState = &state.multisampling;
+        pipelineInfo.pDepthStencilState = &state.depthStencil;
+        pipelineInfo.pColorBlendState = &state.colorBlending;
+        pipelineInfo.pDynamicState = &state.dynamicState;
+        pipelineInfo.layout = this->vkPipelineLayoutHandle->vk;
+        pipelineInfo.renderPass = this->vkRenderPassHandle->vk;
+        pipelineInfo.subpass = 0;
+        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;       // Optional
+        pipelineInfo.basePipelineIndex = -1;                    // Optional
+
+        VkPipelineCache const pipelineCache = this->vkPipelineCacheHandle != nullptr ? this->vkPipelineCacheHandle->vk : VK_NULL_HANDLE;
+
+        if (vkCreateGraphicsPipelines(this->vkDeviceHandle->vk, pipelineCache, 1, &pipelineInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create graphics pipeline.");
         }
+    }
 
-        VkPipelineVertexInputStateCreateInfo vertexInputInfo {};
-        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(config.vertexInfo.vertexTypes.size());
-        vertexInputInfo.pVertexBindingDescriptions = config.vertexInfo.vertexTypes.data();
-        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(config.vertexInfo.attributes.size());
-        vertexInputInfo.pVertexAttributeDescriptions = config.vertexInfo.attributes.data();
 
-        // TODO - Add to config
-        VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
-        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-        inputAssembly.primitiveRestartEnable = VK_FALSE;
-
-        // TODO - Add to config
-/*
-        VkViewport viewport {};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = (float) this->vkSwapChain->config.imageExtent.width;
-        viewport.height = (float) this->vkSwapChain->config.imageExtent.height;
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-
-        VkRect2D scissor {};
-        scissor.offset = {0, 0};
-        scissor.extent = this->vkSwapChain->config.imageExtent;
-*/
-        // TODO - Add to config
-        std::vector<VkDynamicState> const dynamicStates = {
-            VK_DYNAMIC_STATE_VIEWPORT,
-            VK_DYNAMIC_STATE_SCISSOR
-        };
+    GraphicsPipeline::GraphicsPipeline(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
+        std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
+        std::shared_ptr<RenderPassHandle> const& vkRenderPassHandle,
+        GraphicsPipelineConfig const& config,
+        std::vector<std::shared_ptr<GraphicsPipelineLibrary>> const& libraries,
+        bool const optimize
+    ) :
+        HandleWrapper<PipelineHandle>(std::make_shared<PipelineHandle>(vkDeviceHandle)),
+        vkDeviceHandle(vkDeviceHandle),
+        vkPipelineCacheHandle(vkPipelineCacheHandle),
+        vkPipelineLayoutHandle(vkPipelineLayoutHandle),
+        vkRenderPassHandle(vkRenderPassHandle),
+        config(config.resolveDynamicStates(vkDeviceHandle->functions)),
+        fastLinked(!optimize)
+    {
+        INFO(log) << "Linking graphics pipeline from " << libraries.size() << " libraries"
+                  << (optimize ? " (optimized)." : ".") << std::endl;
 
-        // TODO - Add to config
-        VkPipelineDynamicStateCreateInfo dynamicState {};
-        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-        dynamicState.pDynamicStates = dynamicStates.data();
+        VkGraphicsPipelineLibraryFlagsEXT linkedParts = 0;
+        std::vector<VkPipeline> libraryHandles;
 
-        // TODO - Add to config
-        VkPipelineViewportStateCreateInfo viewportState {};
-        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-        viewportState.viewportCount = 1;
-        viewportState.scissorCount = 1;
+        for (auto const& library : libraries) {
+            linkedParts |= library->getParts();
+            libraryHandles.push_back(library->getHandle()->vk);
+        }
 
-        // TODO - Add to config
-        VkPipelineRasterizationStateCreateInfo rasterizer {};
-        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-        rasterizer.depthClampEnable = VK_FALSE;
-        rasterizer.rasterizerDiscardEnable = VK_FALSE;
-        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-        rasterizer.lineWidth = 1.0f;
-        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-        rasterizer.depthBiasEnable = VK_FALSE;
-        rasterizer.depthBiasConstantFactor = 0.0f;          // Optional
-        rasterizer.depthBiasClamp = 0.0f;                   // Optional
-        rasterizer.depthBiasSlopeFactor = 0.0f;             // Optional
-
-        // TODO - Add to config
-        VkPipelineMultisampleStateCreateInfo multisampling {};
-        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-        multisampling.sampleShadingEnable = VK_FALSE;
-        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-        multisampling.minSampleShading = 1.0f;              // Optional
-        multisampling.pSampleMask = nullptr;                // Optional
-        multisampling.alphaToCoverageEnable = VK_FALSE;     // Optional
-        multisampling.alphaToOneEnable = VK_FALSE;          // Optional
-
-        // TODO - Add to config
-        VkPipelineColorBlendAttachmentState colorBlendAttachment {};
-        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        colorBlendAttachment.blendEnable = VK_FALSE;
-        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;     // Optional
-        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;    // Optional
-        colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;                // Optional
-        colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;     // Optional
-        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;    // Optional
-        colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;                // Optional
-
-        // TODO - Add to config
-        VkPipelineColorBlendStateCreateInfo colorBlending{};
-        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-        colorBlending.logicOpEnable = VK_FALSE;
-        colorBlending.logicOp = VK_LOGIC_OP_COPY;           // Optional
-        colorBlending.attachmentCount = 1;
-        colorBlending.pAttachments = &colorBlendAttachment;
-        colorBlending.blendConstants[0] = 0.0f;             // Optional
-        colorBlending.blendConstants[1] = 0.0f;             // Optional
-        colorBlending.blendConstants[2] = 0.0f;             // Optional
-        colorBlending.blendConstants[3] = 0.0f;             // Optional
+        if (linkedParts != GraphicsPipelineLibrary::allParts) {
+            throw std::runtime_error("Failed to link graphics pipeline: Libraries do not cover every pipeline part.");
+        }
+
+        VkPipelineLibraryCreateInfoKHR libraryInfo {};
+        libraryInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+        libraryInfo.libraryCount = static_cast<uint32_t>(libraryHandles.size());
+        libraryInfo.pLibraries = libraryHandles.data();
 
         VkGraphicsPipelineCreateInfo pipelineInfo {};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineInfo.stageCount = static_cast<uint32_t>(config.shaderStages.size());
-        pipelineInfo.pStages = shaderStages;
-        pipelineInfo.pVertexInputState = &vertexInputInfo;
-        pipelineInfo.pInputAssemblyState = &inputAssembly;
-        pipelineInfo.pViewportState = &viewportState;
-        pipelineInfo.pRasterizationState = &rasterizer;
-        pipelineInfo.pMultisampleState = &multisampling;
-        pipelineInfo.pDepthStencilState = nullptr;              // Optional
-        pipelineInfo.pColorBlendState = &colorBlending;
-        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.pNext = &libraryInfo;
+        pipelineInfo.flags = optimize ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0;
         pipelineInfo.layout = this->vkPipelineLayoutHandle->vk;
         pipelineInfo.renderPass = this->vkRenderPassHandle->vk;
         pipelineInfo.subpass = 0;
-        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;       // Optional
-        pipelineInfo.basePipelineIndex = -1;                    // Optional
+        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+        pipelineInfo.basePipelineIndex = -1;
 
-        if (vkCreateGraphicsPipelines(this->vkDeviceHandle->vk, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
-            throw std::runtime_error("failed to create graphics pipeline.");
+        VkPipelineCache const pipelineCache = this->vkPipelineCacheHandle != nullptr ? this->vkPipelineCacheHandle->vk : VK_NULL_HANDLE;
+
+        if (vkCreateGraphicsPipelines(this->vkDeviceHandle->vk, pipelineCache, 1, &pipelineInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to link graphics pipeline.");
+        }
+    }
+
+
+    GraphicsPipelineConfig GraphicsPipelineLibrary::getPartConfig(
+        GraphicsPipelineConfig const& config,
+        VkGraphicsPipelineLibraryFlagsEXT const parts
+    ) {
+        GraphicsPipelineConfig partConfig;
+        partConfig.dynamicStates = config.dynamicStates;
+
+        if (parts & VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT) {
+            partConfig.vertexInfo = config.vertexInfo;
+            partConfig.topology = config.topology;
+            partConfig.primitiveRestartEnable = config.primitiveRestartEnable;
+        }
+
+        if (parts & VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT) {
+            for (auto const& shaderStage : config.shaderStages) {
+                if (shaderStage.flagBits != VK_SHADER_STAGE_FRAGMENT_BIT) {
+                    partConfig.shaderStages.push_back(shaderStage);
+                }
+            }
+
+            partConfig.rasterizerDiscardEnable = config.rasterizerDiscardEnable;
+            partConfig.polygonMode = config.polygonMode;
+            partConfig.cullMode = config.cullMode;
+            partConfig.frontFace = config.frontFace;
+            partConfig.depthBiasEnable = config.depthBiasEnable;
+        }
+
+        if (parts & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT) {
+            for (auto const& shaderStage : config.shaderStages) {
+                if (shaderStage.flagBits == VK_SHADER_STAGE_FRAGMENT_BIT) {
+                    partConfig.shaderStages.push_back(shaderStage);
+                }
+            }
+
+            partConfig.depthTestEnable = config.depthTestEnable;
+            partConfig.depthWriteEnable = config.depthWriteEnable;
+            partConfig.depthCompareOp = config.depthCompareOp;
+        }
+
+        if (parts & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT) {
+            partConfig.blendEnable = config.blendEnable;
+            partConfig.srcColorBlendFactor = config.srcColorBlendFactor;
+            partConfig.dstColorBlendFactor = config.dstColorBlendFactor;
+            partConfig.colorBlendOp = config.colorBlendOp;
+            partConfig.srcAlphaBlendFactor = config.srcAlphaBlendFactor;
+            partConfig.dstAlphaBlendFactor = config.dstAlphaBlendFactor;
+            partConfig.alphaBlendOp = config.alphaBlendOp;
+            partConfig.colorWriteMask = config.colorWriteMask;
+        }
+
+        return partConfig;
+    }
+
+
+    GraphicsPipelineLibrary::GraphicsPipelineLibrary(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
+        std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
+        std::shared_ptr<RenderPassHandle> const& vkRenderPassHandle,
+        GraphicsPipelineConfig const& config,
+        VkGraphicsPipelineLibraryFlagsEXT const parts
+    ) :
+        HandleWrapper<PipelineHandle>(std::make_shared<PipelineHandle>(vkDeviceHandle)),
+        vkDeviceHandle(vkDeviceHandle),
+        vkPipelineCacheHandle(vkPipelineCacheHandle),
+        vkPipelineLayoutHandle(vkPipelineLayoutHandle),
+        vkRenderPassHandle(vkRenderPassHandle),
+        config(getPartConfig(config.resolveDynamicStates(vkDeviceHandle->functions), parts)),
+        parts(parts)
+    {
+        INFO(log) << "Creating new graphics pipeline library with parts " << parts << "." << std::endl;
+
+        GraphicsPipelineState const state(this->config);
+
+        VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo {};
+        libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+        libraryInfo.flags = parts;
+
+        // Only the state belonging to the requested parts is read by the driver
+        VkGraphicsPipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.pNext = &libraryInfo;
+        pipelineInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+        pipelineInfo.stageCount = static_cast<uint32_t>(state.shaderStages.size());
+        pipelineInfo.pStages = state.shaderStages.data();
+        pipelineInfo.pVertexInputState = &state.vertexInput;
+        pipelineInfo.pInputAssemblyState = &state.inputAssembly;
+        pipelineInfo.pViewportState = &state.viewportState;
+        pipelineInfo.pRasterizationState = &state.rasterizer;
+        pipelineInfo.pMultisampleState = &state.multisampling;
+        pipelineInfo.pDepthStencilState = &state.depthStencil;
+        pipelineInfo.pColorBlendState = &state.colorBlending;
+        pipelineInfo.pDynamicState = &state.dynamicState;
+        pipelineInfo.layout = this->vkPipelineLayoutHandle != nullptr ? this->vkPipelineLayoutHandle->vk : VK_NULL_HANDLE;
+        pipelineInfo.renderPass = this->vkRenderPassHandle != nullptr ? this->vkRenderPassHandle->vk : VK_NULL_HANDLE;
+        pipelineInfo.subpass = 0;
+        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+        pipelineInfo.basePipelineIndex = -1;
+
+        VkPipelineCache const pipelineCache = this->vkPipelineCacheHandle != nullptr ? this->vkPipelineCacheHandle->vk : VK_NULL_HANDLE;
+
+        if (vkCreateGraphicsPipelines(this->vkDeviceHandle->vk, pipelineCache, 1, &pipelineInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create graphics pipeline library.");
         }
     }
 
@@ -3,6 +3,9 @@
 #include "utils/misc/logging.hpp"
 #include "utils/vulkan/handles.hpp"
 
+#include <algorithm>
+#include <type_traits>
+
 
 namespace utils::vulkan {
 
@@ -59,6 +62,17 @@ namespace utils::vulkan {
 
             attributes.push_back(vertexAttribute);
         }
+
+        bool operator==(VertexInfo const& other) const;
+
+        bool operator!=(VertexInfo const& other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Hash the vertex layout.
+         */
+        std::size_t hash() const;
     };
 
 
@@ -70,18 +84,75 @@ namespace utils::vulkan {
         VkShaderStageFlagBits flagBits;
         std::string const shaderMain;
 
+        // Specialization constant layout and tightly packed values
+        std::vector<VkSpecializationMapEntry> specializationEntries;
+        std::vector<uint8_t> specializationData;
+
+        /**
+         * @brief Set the value of a specialization constant (layout(constant_id = N) in GLSL).
+         * Setting a constant again replaces its value, the type must stay the same.
+         * @param constantId Constant id in the shader.
+         * @param value Value to bake into the pipeline, bool is converted to VkBool32.
+         */
+        template<typename T>
+        ShaderStageConfig& setSpecializationConstant(uint32_t const constantId, T const value) {
+            static_assert(std::is_arithmetic_v<T>, "Specialization constants must be scalar values.");
+
+            // Shader booleans are 32 bits wide
+            if constexpr (std::is_same_v<T, bool>) {
+                VkBool32 const boolValue = value ? VK_TRUE : VK_FALSE;
+                setSpecializationData(constantId, &boolValue, sizeof(boolValue));
+            } else {
+                setSpecializationData(constantId, &value, sizeof(value));
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Set the raw bytes of a specialization constant.
+         * @param constantId Constant id in the shader.
+         * @param data Pointer to the constant value.
+         * @param size Size of the constant value in bytes.
+         */
+        void setSpecializationData(uint32_t const constantId, void const * const data, std::size_t const size);
+
         /**
          * @brief Convert the config to vulkan create info object.
+         * @param specializationInfo Storage for the specialization info, must outlive the returned object.
          * @return Pipeline shader stage create info object.
          */
-        VkPipelineShaderStageCreateInfo toVulkan() const {
+        VkPipelineShaderStageCreateInfo toVulkan(VkSpecializationInfo& specializationInfo) const {
             VkPipelineShaderStageCreateInfo vk {};
             vk.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
             vk.stage = this->flagBits;
             vk.module = this->shaderModule->vk;
             vk.pName = this->shaderMain.c_str();
+
+            if (!this->specializationEntries.empty()) {
+                specializationInfo.mapEntryCount = static_cast<uint32_t>(this->specializationEntries.size());
+                specializationInfo.pMapEntries = this->specializationEntries.data();
+                specializationInfo.dataSize = this->specializationData.size();
+                specializationInfo.pData = this->specializationData.data();
+                vk.pSpecializationInfo = &specializationInfo;
+            }
+
             return vk;
         }
+
+        /**
+         * @brief Shader stages are equal if they use the same module, stage, entry point and constants.
+         */
+        bool operator==(ShaderStageConfig const& other) const;
+
+        bool operator!=(ShaderStageConfig const& other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Hash the shader stage.
+         */
+        std::size_t hash() const;
     };
 
 
@@ -105,7 +176,166 @@ namespace utils::vulkan {
             shaderStages.push_back({shaderModule, shaderFlags, shaderMain});
         }
 
+        /**
+         * @brief Set a specialization constant on a shader stage.
+         * @param shaderFlags Stage of the shader to set the constant on, it must already be added.
+         * @param constantId Constant id in the shader.
+         * @param value Value to bake into the pipeline.
+         */
+        template<typename T>
+        GraphicsPipelineConfig& setSpecializationConstant(
+            VkShaderStageFlagBits const shaderFlags,
+            uint32_t const constantId,
+            T const value
+        ) {
+            for (auto& shaderStage : shaderStages) {
+                if (shaderStage.flagBits == shaderFlags) {
+                    shaderStage.setSpecializationConstant(constantId, value);
+                    return *this;
+                }
+            }
+
+            throw std::runtime_error("Failed to set specialization constant: No shader stage with matching flags.");
+        }
+
         VertexInfo vertexInfo;
+
+        // Input assembly
+        VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        bool primitiveRestartEnable = false;
+
+        // Rasterization
+        bool rasterizerDiscardEnable = false;
+        VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+        VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+        VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        bool depthBiasEnable = false;
+
+        // Depth
+        bool depthTestEnable = false;
+        bool depthWriteEnable = false;
+        VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+
+        // Blending, applied to the single color attachment
+        bool blendEnable = false;
+        VkBlendFactor srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+        VkBlendFactor dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+        VkBlendOp colorBlendOp = VK_BLEND_OP_ADD;
+        VkBlendFactor srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        VkBlendFactor dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        VkBlendOp alphaBlendOp = VK_BLEND_OP_ADD;
+        VkColorComponentFlags colorWriteMask =
+            VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+        // State set with CommandBuffer setters rather than baked into the pipeline
+        std::vector<VkDynamicState> dynamicStates = {
+            VK_DYNAMIC_STATE_VIEWPORT,
+            VK_DYNAMIC_STATE_SCISSOR
+        };
+
+        /**
+         * @brief Make a piece of pipeline state dynamic.
+         * Extension states the device doesn't support are dropped when the pipeline is created,
+         * and the value in this config is baked in instead. Dynamic topology must stay within
+         * the topology class of the topology in this config.
+         * @param dynamicState The state to make dynamic (e.g. VK_DYNAMIC_STATE_CULL_MODE_EXT).
+         */
+        GraphicsPipelineConfig& addDynamicState(VkDynamicState const dynamicState) {
+            if (!isDynamic(dynamicState)) {
+                dynamicStates.push_back(dynamicState);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Check whether a piece of pipeline state is dynamic.
+         */
+        bool isDynamic(VkDynamicState const dynamicState) const {
+            return std::find(dynamicStates.begin(), dynamicStates.end(), dynamicState) != dynamicStates.end();
+        }
+
+        /**
+         * @brief Get a copy of the config with unsupported dynamic states removed.
+         * @param functions Extension functions of the device the pipeline will be created on.
+         */
+        GraphicsPipelineConfig resolveDynamicStates(DeviceFunctions const& functions) const;
+
+        /**
+         * @brief Configs are equal if they describe identical pipeline state.
+         * State which is dynamic in both configs is ignored, so configs that differ only in
+         * dynamic state share a pipeline.
+         */
+        bool operator==(GraphicsPipelineConfig const& other) const;
+
+        bool operator!=(GraphicsPipelineConfig const& other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Hash the full pipeline state described by the config.
+         * Stable for the lifetime of the shader modules it references.
+         */
+        std::size_t hash() const;
+    };
+
+
+    /**
+     * @brief Part of a graphics pipeline compiled on its own (VK_EXT_graphics_pipeline_library).
+     * Parts are linked into complete pipelines by GraphicsPipeline. Each part only reads the
+     * config state belonging to it, so parts can be shared between many pipelines.
+     */
+    class GraphicsPipelineLibrary : public HandleWrapper<PipelineHandle> {
+    private:
+        static utils::Logger log;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+        std::shared_ptr<PipelineCacheHandle> const vkPipelineCacheHandle;
+        std::shared_ptr<PipelineLayoutHandle> const vkPipelineLayoutHandle;
+        std::shared_ptr<RenderPassHandle> const vkRenderPassHandle;
+
+        GraphicsPipelineConfig const config;
+        VkGraphicsPipelineLibraryFlagsEXT const parts;
+
+    public:
+        static constexpr VkGraphicsPipelineLibraryFlagsEXT allParts =
+            VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT |
+            VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT |
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT |
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+
+        /**
+         * @brief Create a graphics pipeline library.
+         * The vertex input part needs neither layout nor render pass, and the fragment output
+         * part needs no layout, so those may be nullptr.
+         * @param parts Pipeline parts to compile (VK_GRAPHICS_PIPELINE_LIBRARY_*_BIT_EXT).
+         */
+        GraphicsPipelineLibrary(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
+            std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
+            std::shared_ptr<RenderPassHandle> const& vkRenderPassHandle,
+            GraphicsPipelineConfig const& config,
+            VkGraphicsPipelineLibraryFlagsEXT const parts);
+
+        /**
+         * @brief Reduce a config to the state read by some pipeline parts.
+         * Everything else is reset to defaults, so configs which only differ outside of
+         * the given parts produce equal part configs.
+         * @param config Full pipeline config.
+         * @param parts Pipeline parts to keep state for.
+         * @return Config containing only the state of the given parts.
+         */
+        static GraphicsPipelineConfig getPartConfig(
+            GraphicsPipelineConfig const& config,
+            VkGraphicsPipelineLibraryFlagsEXT const parts);
+
+        /**
+         * @brief Get the pipeline parts contained in this library.
+         */
+        VkGraphicsPipelineLibraryFlagsEXT getParts() const {
+            return this->parts;
+        }
     };
 
 
@@ -114,18 +344,50 @@ namespace utils::vulkan {
         static utils::Logger log;
 
         std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+        std::shared_ptr<PipelineCacheHandle> const vkPipelineCacheHandle;
         std::shared_ptr<PipelineLayoutHandle> const vkPipelineLayoutHandle;
         std::shared_ptr<RenderPassHandle> const vkRenderPassHandle;
 
         GraphicsPipelineConfig const config;
+        bool const fastLinked;
 
     public:
         GraphicsPipeline(
             std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
             std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
             std::shared_ptr<RenderPassHandle> const& vkRenderPassHandle,
             GraphicsPipelineConfig const& config);
 
+        /**
+         * @brief Link a graphics pipeline from pipeline libraries.
+         * Libraries must have been created from the same config, layout and render pass.
+         * @param libraries Libraries which together contain every pipeline part.
+         * @param optimize Perform link time optimization. Without it linking is fast, but
+         * the resulting pipeline may run slower than a fully compiled one.
+         */
+        GraphicsPipeline(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            std::shared_ptr<PipelineCacheHandle> const& vkPipelineCacheHandle,
+            std::shared_ptr<PipelineLayoutHandle> const& vkPipelineLayoutHandle,
+            std::shared_ptr<RenderPassHandle> const& vkRenderPassHandle,
+            GraphicsPipelineConfig const& config,
+            std::vector<std::shared_ptr<GraphicsPipelineLibrary>> const& libraries,
+            bool const optimize);
+
+        /**
+         * @brief Get the config the pipeline was created from.
+         */
+        GraphicsPipelineConfig const& getConfig() const {
+            return this->config;
+        }
+
+        /**
+         * @brief Check whether the pipeline was linked from libraries without optimization.
+         */
+        bool isFastLinked() const {
+            return this->fastLinked;
+        }
     };
 
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "utils/vulkan/device_functions.hpp"
+
 #include "vulkan/vulkan.h"
 
 #include <memory>
@@ -23,9 +25,9 @@ namespace utils::vulkan {
 
         /**
          * @brief Retrieve handle of wrapped vulkan object.
-         * @return Shared pointer to handle object.
+         * @return Reference to shared pointer to handle object, copy it to share ownership.
          */
-        std::shared_ptr<T> getHandle() const {
+        std::shared_ptr<T> const& getHandle() const {
             return vkHandle;
         }
     };
@@ -67,6 +69,7 @@ namespace utils::vulkan {
     class DeviceHandle {
     public:
         VkDevice_T * vk;
+        DeviceFunctions functions;
 
         ~DeviceHandle() {
             vkDestroyDevice(this->vk, nullptr);
@@ -278,6 +281,25 @@ namespace utils::vulkan {
     };
 
 
+    /**
+     * @brief Class for managing lifetime of VkPipelineCache objects.
+     */
+    class PipelineCacheHandle {
+    private:
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+    public:
+        VkPipelineCache_T * vk;
+
+        PipelineCacheHandle(std::shared_ptr<DeviceHandle> const& vkDeviceHandle) :
+            vkDeviceHandle(vkDeviceHandle) {}
+
+        ~PipelineCacheHandle() {
+            vkDestroyPipelineCache(this->vkDeviceHandle->vk, this->vk, nullptr);
+        }
+    };
+
+
     /**
      * @brief Class for managing lifetime of VkSemaphore objects.
      */
@@ -390,4 +412,26 @@ namespace utils::vulkan {
             vkDestroyDescriptorPool(this->vkDeviceHandle->vk, this->vk, nullptr);
         }
     };
+
+
+    /**
+     * @brief Class for managing the lifetime of VkDescriptorUpdateTemplate objects.
+     */
+    class DescriptorUpdateTemplateHandle {
+    private:
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+    public:
+        VkDescriptorUpdateTemplate_T * vk = nullptr;
+
+        DescriptorUpdateTemplateHandle(std::shared_ptr<DeviceHandle> const& vkDeviceHandle) :
+            vkDeviceHandle(vkDeviceHandle) {}
+
+        // The destroy function comes from an extension, so only call it if creation succeeded
+        ~DescriptorUpdateTemplateHandle() {
+            if (this->vk != nullptr) {
+                this->vkDeviceHandle->functions.vkDestroyDescriptorUpdateTemplate(this->vkDeviceHandle->vk, this->vk, nullptr);
+            }
+        }
+    };
 }
@@ -57,22 +57,42 @@ namespace utils::vulkan {
     struct QueueConstraints {
         uint32_t requiredFlags;
         std::shared_ptr<Surface> presentSurface;
+        uint32_t avoidedFlags;
+        float priority;
 
         /**
          * @brief All parameters constructor.
          * @param requiredFlags Required queue flags.
          * @param presentSurface Shared pointer to a present surface that the queue must support.
+         * @param avoidedFlags Queue flags the family should preferably not have. Families without
+         * them are chosen when available, e.g. avoid VK_QUEUE_GRAPHICS_BIT to get a dedicated
+         * compute queue which can run alongside the graphics queue.
+         * @param priority Scheduling priority of the queue relative to others on the device, 0.0 to 1.0.
          */
         QueueConstraints(
             uint32_t const requiredFlags,
-            std::shared_ptr<Surface> const& presentSurface
+            std::shared_ptr<Surface> const& presentSurface = nullptr,
+            uint32_t const avoidedFlags = 0,
+            float const priority = 1.0f
         ):
             requiredFlags(requiredFlags),
-            presentSurface(presentSurface)
+            presentSurface(presentSurface),
+            avoidedFlags(avoidedFlags),
+            priority(priority)
         {}
     };
 
 
+    /**
+     * @brief Queue family and priority selected for a named queue.
+     */
+    struct QueueRequest {
+        uint32_t familyIndex;
+        uint32_t familyQueueCount;
+        float priority;
+    };
+
+
     /**
      * @brief Helper class for containing named queue requirements.
      */
@@ -1,4 +1,7 @@
 #include "utils/vulkan/image.hpp"
+#include "utils/vulkan/pipeline_barrier.hpp"
+
+#include <algorithm>
 
 
 namespace utils::vulkan {
@@ -6,10 +9,35 @@ namespace utils::vulkan {
     utils::Logger Image::log("Image");
 
 
+    VkImageAspectFlags getFormatAspectMask(VkFormat const format) {
+        switch (format) {
+            case VK_FORMAT_D16_UNORM:
+            case VK_FORMAT_X8_D24_UNORM_PACK32:
+            case VK_FORMAT_D32_SFLOAT:
+                return VK_IMAGE_ASPECT_DEPTH_BIT;
+
+            case VK_FORMAT_S8_UINT:
+                return VK_IMAGE_ASPECT_STENCIL_BIT;
+
+            case VK_FORMAT_D16_UNORM_S8_UINT:
+            case VK_FORMAT_D24_UNORM_S8_UINT:
+            case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+
+            default:
+                return VK_IMAGE_ASPECT_COLOR_BIT;
+        }
+    }
+
+
     Image::Image(std::shared_ptr<ImageHandle> const& vkImageHandle, std::shared_ptr<DeviceHandle> const& vkDeviceHandle) :
-        HandleWrapper<ImageHandle>(vkImageHandle), vkDeviceHandle(vkDeviceHandle)
+        HandleWrapper<ImageHandle>(vkImageHandle),
+        vkDeviceHandle(vkDeviceHandle),
+        aspectMask(VK_IMAGE_ASPECT_COLOR_BIT),
+        mutableSettings({VK_IMAGE_LAYOUT_UNDEFINED, 1, 1})
     {
         INFO(log) << "Wrapping swap chain image." << std::endl;
+        this->resetSubresourceStates(VK_IMAGE_LAYOUT_UNDEFINED);
     }
 
 
@@ -19,6 +47,7 @@ namespace utils::vulkan {
     ) :
         HandleWrapper<ImageHandle>(std::make_shared<ImageHandle>(vkDeviceHandle)),
         vkDeviceHandle(vkDeviceHandle),
+        aspectMask(getFormatAspectMask(config.format)),
         mutableSettings(config.getMutableSettings())
     {
         INFO(log) << "Creating image." << std::endl;
@@ -41,6 +70,8 @@ namespace utils::vulkan {
         if (vkCreateImage(this->vkDeviceHandle->vk, &imageInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create image.");
         }
+
+        this->resetSubresourceStates(config.initialLayout);
     }
 
 
@@ -71,17 +102,168 @@ namespace utils::vulkan {
         barrier.newLayout = newSettings.layout;
         barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.aspectMask = this->aspectMask;
         barrier.subresourceRange.baseMipLevel = 0;
         barrier.subresourceRange.levelCount = newSettings.mipLevelCount;
         barrier.subresourceRange.baseArrayLayer = 0;
         barrier.subresourceRange.layerCount = newSettings.layerCount;
-        barrier.srcAccessMask = 0;  // TODO
-        barrier.dstAccessMask = 0;  // TODO
+        barrier.srcAccessMask = getImageLayoutSourceScope(oldSettings.layout).access;
+        barrier.dstAccessMask = getImageLayoutDestinationScope(newSettings.layout).access;
 
         this->mutableSettings = newSettings;
+        this->resetSubresourceStates(newSettings.layout);
 
         return barrier;
     }
 
+
+    void Image::resetSubresourceStates(VkImageLayout const layout) {
+        ImageSubresourceState subresourceState {};
+        subresourceState.layout = layout;
+
+        // Undefined and preinitialized contents have no device work to wait for
+        if (layout != VK_IMAGE_LAYOUT_UNDEFINED && layout != VK_IMAGE_LAYOUT_PREINITIALIZED) {
+            auto const scope = getImageLayoutDestinationScope(layout);
+            subresourceState.state.lastWrite.stages = scope.stages;
+            subresourceState.state.reads = scope;
+        }
+
+        auto const count = this->mutableSettings.mipLevelCount * this->mutableSettings.layerCount;
+        this->subresourceStates.assign(count, subresourceState);
+    }
+
+
+    VkImageSubresourceRange Image::getFullRange() const {
+        VkImageSubresourceRange range {};
+        range.aspectMask = this->aspectMask;
+        range.baseMipLevel = 0;
+        range.levelCount = this->mutableSettings.mipLevelCount;
+        range.baseArrayLayer = 0;
+        range.layerCount = this->mutableSettings.layerCount;
+        return range;
+    }
+
+
+    VkImageLayout Image::getLayout(uint32_t const mipLevel, uint32_t const layer) const {
+        if (mipLevel >= this->mutableSettings.mipLevelCount || layer >= this->mutableSettings.layerCount) {
+            throw std::runtime_error("Unable to get image layout, subresource is out of range.");
+        }
+
+        return this->subresourceStates[mipLevel * this->mutableSettings.layerCount + layer].layout;
+    }
+
+
+    ResourceState Image::getCombinedState() const {
+        ResourceState combined;
+
+        for (auto const& subresourceState : this->subresourceStates) {
+            combined |= subresourceState.state;
+        }
+
+        return combined;
+    }
+
+
+    void Image::discardContents(ResourceState const& priorState) {
+        ImageSubresourceState subresourceState {};
+        subresourceState.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        subresourceState.state = priorState;
+
+        std::fill(this->subresourceStates.begin(), this->subresourceStates.end(), subresourceState);
+        this->mutableSettings.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+
+
+    void Image::transition(
+        PipelineBarrier& barrier,
+        VkImageSubresourceRange const& range,
+        VkImageLayout const layout,
+        AccessScope const& usage
+    ) {
+        auto const& settings = this->mutableSettings;
+
+        uint32_t const levelCount = range.levelCount == VK_REMAINING_MIP_LEVELS ?
+            settings.mipLevelCount - range.baseMipLevel : range.levelCount;
+
+        uint32_t const layerCount = range.layerCount == VK_REMAINING_ARRAY_LAYERS ?
+            settings.layerCount - range.baseArrayLayer : range.layerCount;
+
+        if (range.baseMipLevel + levelCount > settings.mipLevelCount ||
+            range.baseArrayLayer + layerCount > settings.layerCount) {
+            throw std::runtime_error("Unable to transition image, subresource range is out of range.");
+        }
+
+        // Transition a block of subresources which all share the same prior state
+        auto const transitionBlock = [&](
+            uint32_t const baseMipLevel, uint32_t const blockLevelCount,
+            uint32_t const baseArrayLayer, uint32_t const blockLayerCount
+        ) {
+            auto const prior = this->getSubresourceState(baseMipLevel, baseArrayLayer);
+            auto next = prior;
+            next.layout = layout;
+
+            AccessScope src;
+            if (transitionResourceState(next.state, usage, prior.layout != layout, &src)) {
+                VkImageMemoryBarrier imageBarrier {};
+                imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                imageBarrier.image = this->vkHandle->vk;
+                imageBarrier.oldLayout = prior.layout;
+                imageBarrier.newLayout = layout;
+                imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.subresourceRange.aspectMask = range.aspectMask;
+                imageBarrier.subresourceRange.baseMipLevel = baseMipLevel;
+                imageBarrier.subresourceRange.levelCount = blockLevelCount;
+                imageBarrier.subresourceRange.baseArrayLayer = baseArrayLayer;
+                imageBarrier.subresourceRange.layerCount = blockLayerCount;
+                imageBarrier.srcAccessMask = src.access;
+                imageBarrier.dstAccessMask = usage.access;
+
+                barrier.addImageBarrier(imageBarrier, src.stages, usage.stages);
+            }
+
+            for (uint32_t mip = baseMipLevel; mip < baseMipLevel + blockLevelCount; mip++) {
+                for (uint32_t layer = baseArrayLayer; layer < baseArrayLayer + blockLayerCount; layer++) {
+                    this->getSubresourceState(mip, layer) = next;
+                }
+            }
+        };
+
+        auto const first = this->getSubresourceState(range.baseMipLevel, range.baseArrayLayer);
+        bool uniform = true;
+
+        for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + levelCount && uniform; mip++) {
+            for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + layerCount; layer++) {
+                if (!(this->getSubresourceState(mip, layer) == first)) {
+                    uniform = false;
+                    break;
+                }
+            }
+        }
+
+        if (uniform) {
+            // Common case, one barrier covers the whole range
+            transitionBlock(range.baseMipLevel, levelCount, range.baseArrayLayer, layerCount);
+        } else {
+            // One barrier per run of layers with matching state, within each mip level
+            for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + levelCount; mip++) {
+                uint32_t runStart = range.baseArrayLayer;
+
+                for (uint32_t layer = runStart + 1; layer <= range.baseArrayLayer + layerCount; layer++) {
+                    bool const runEnds = layer == range.baseArrayLayer + layerCount ||
+                        !(this->getSubresourceState(mip, layer) == this->getSubresourceState(mip, runStart));
+
+                    if (runEnds) {
+                        transitionBlock(mip, 1, runStart, layer - runStart);
+                        runStart = layer;
+                    }
+                }
+            }
+        }
+
+        if (levelCount == settings.mipLevelCount && layerCount == settings.layerCount) {
+            this->mutableSettings.layout = layout;
+        }
+    }
+
 }
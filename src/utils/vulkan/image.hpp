@@ -4,10 +4,12 @@
 #include "utils/vulkan/handles.hpp"
 #include "utils/vulkan/image_view.hpp"
 #include "utils/vulkan/device_memory.hpp"
+#include "utils/vulkan/pipeline_barrier.hpp"
 
 #include "vulkan/vulkan.h"
 
 #include <memory>
+#include <vector>
 
 
 namespace utils::vulkan {
@@ -98,14 +100,53 @@ namespace utils::vulkan {
     };
 
 
+    /**
+     * @brief Layout and synchronization state of a single image subresource (mip level and layer).
+     */
+    struct ImageSubresourceState {
+        VkImageLayout layout;
+        ResourceState state;
+
+        bool operator==(ImageSubresourceState const& other) const {
+            return layout == other.layout && state == other.state;
+        }
+    };
+
+
+    /**
+     * @brief Get the aspects present in an image format.
+     * @param format Format of the image.
+     * @return Depth and/or stencil aspects for depth formats, color otherwise.
+     */
+    VkImageAspectFlags getFormatAspectMask(VkFormat const format);
+
+
     class Image : public HandleWrapper<ImageHandle> {
     private:
         static utils::Logger log;
 
         std::shared_ptr<DeviceHandle> const vkDeviceHandle;
 
+        VkImageAspectFlags const aspectMask;
+
         MutableImageSettings mutableSettings;
 
+        // One entry per subresource, indexed by mip level then array layer
+        std::vector<ImageSubresourceState> subresourceStates;
+
+        /**
+         * @brief Reset all subresource states to a layout, with the layout scope as the last write.
+         * @param layout Layout to reset the subresources to.
+         */
+        void resetSubresourceStates(VkImageLayout const layout);
+
+        /**
+         * @brief Get the state of a subresource.
+         */
+        ImageSubresourceState& getSubresourceState(uint32_t const mipLevel, uint32_t const layer) {
+            return this->subresourceStates[mipLevel * this->mutableSettings.layerCount + layer];
+        }
+
     public:
         Image(std::shared_ptr<ImageHandle> const& vkImageHandle, std::shared_ptr<DeviceHandle> const& vkDeviceHandle);
         Image(std::shared_ptr<DeviceHandle> const& vkDeviceHandle, ImageConfig const& config);
@@ -138,11 +179,54 @@ namespace utils::vulkan {
 
         /**
          * @brief Update image metadata based on barrier details.
+         * Transitions every subresource, discarding any per-subresource state.
          * @param newSettings New mutable image settings.
          * @return Image memory barrier required to update mutable image settings.
          */
         VkImageMemoryBarrier updateSettings(MutableImageSettings const& newSettings);
 
+        /**
+         * @brief Get a subresource range covering every mip level and layer of the image.
+         */
+        VkImageSubresourceRange getFullRange() const;
+
+        /**
+         * @brief Get the current layout of a single subresource.
+         * @param mipLevel Mip level of the subresource.
+         * @param layer Array layer of the subresource.
+         */
+        VkImageLayout getLayout(uint32_t const mipLevel, uint32_t const layer) const;
+
+        /**
+         * @brief Get the combined state of every subresource.
+         * @return State which orders after all previous uses of the image.
+         */
+        ResourceState getCombinedState() const;
+
+        /**
+         * @brief Discard image contents, returning every subresource to the undefined layout.
+         * Used when the image's memory has been aliased by another resource.
+         * @param priorState State which the next use must wait on, e.g. the combined state
+         * of resources which previously occupied the same memory.
+         */
+        void discardContents(ResourceState const& priorState = ResourceState());
+
+        /**
+         * @brief Record a new use of a subresource range, adding any barriers it requires.
+         * Subresources which are already in the right layout and have been made visible to
+         * the new use get no barrier. The mutable settings layout follows the transition when
+         * the range covers the whole image.
+         * @param barrier Pipeline barrier to add image memory barriers to.
+         * @param range Subresource range being used, VK_REMAINING_* counts are accepted.
+         * @param layout Layout the subresources must be in for the new use.
+         * @param usage Stages and accesses of the new use.
+         */
+        void transition(
+            PipelineBarrier& barrier,
+            VkImageSubresourceRange const& range,
+            VkImageLayout const layout,
+            AccessScope const& usage);
+
     };
 
 }
@@ -0,0 +1,60 @@
+#include "utils/vulkan/indirect_commands.hpp"
+
+#include <cstring>
+
+
+namespace utils::vulkan {
+
+    uint32_t IndexedIndirectCommands::addDraw(
+        uint32_t const indexCount,
+        uint32_t const instanceCount,
+        uint32_t const firstIndex,
+        int32_t const vertexOffset,
+        uint32_t const firstInstance
+    ) {
+        VkDrawIndexedIndirectCommand command {};
+        command.indexCount = indexCount;
+        command.instanceCount = instanceCount;
+        command.firstIndex = firstIndex;
+        command.vertexOffset = vertexOffset;
+        command.firstInstance = firstInstance;
+
+        this->commands.push_back(command);
+        return static_cast<uint32_t>(this->commands.size() - 1);
+    }
+
+
+    void IndexedIndirectCommands::clear() {
+        this->commands.clear();
+    }
+
+
+    void IndexedIndirectCommands::write(std::shared_ptr<Buffer> const& buffer, uint64_t const offset) const {
+        if (buffer->getMappedMemory() == nullptr) {
+            throw std::runtime_error("Unable to write indirect commands, buffer is not mapped.");
+        }
+
+        if (offset + this->getSize() > buffer->getMemorySize()) {
+            throw std::runtime_error("Unable to write indirect commands, buffer is too small.");
+        }
+
+        uint8_t * const destination = static_cast<uint8_t *>(buffer->getMappedMemory()) + offset;
+        memcpy(destination, this->commands.data(), this->getSize());
+    }
+
+
+    void IndexedIndirectCommands::recordUpload(
+        std::shared_ptr<CommandBuffer> const& commandBuffer,
+        std::shared_ptr<Buffer> const& stagingBuffer,
+        std::shared_ptr<Buffer> const& deviceBuffer,
+        uint64_t const offset
+    ) const {
+        if (offset + this->getSize() > deviceBuffer->getMemorySize()) {
+            throw std::runtime_error("Unable to upload indirect commands, device buffer is too small.");
+        }
+
+        this->write(stagingBuffer, 0);
+        commandBuffer->copyBuffer(stagingBuffer, deviceBuffer, 0, offset, this->getSize());
+    }
+
+}
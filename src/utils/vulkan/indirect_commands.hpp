@@ -0,0 +1,83 @@
+#pragma once
+
+#include "utils/vulkan/buffer.hpp"
+#include "utils/vulkan/command_buffer.hpp"
+
+#include "vulkan/vulkan.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Helper for building arrays of indexed indirect draw commands.
+     * Commands are accumulated on the host, then written to a host visible buffer or
+     * uploaded to a device local buffer via a staging buffer, ready for use with
+     * CommandBuffer::drawIndexedIndirect and CommandBuffer::drawIndexedIndirectCount.
+     */
+    class IndexedIndirectCommands {
+    private:
+        std::vector<VkDrawIndexedIndirectCommand> commands;
+
+    public:
+        static uint32_t constexpr stride = sizeof(VkDrawIndexedIndirectCommand);
+
+        /**
+         * @brief Add a draw command.
+         * @param indexCount The number of vertices to draw.
+         * @param instanceCount The number of instances to draw.
+         * @param firstIndex Base index within the index buffer.
+         * @param vertexOffset An offset into the vertex buffer, added to each index.
+         * @param firstInstance Instance ID of the first instance to draw.
+         * @return Index of the new command within the command array.
+         */
+        uint32_t addDraw(
+            uint32_t const indexCount,
+            uint32_t const instanceCount,
+            uint32_t const firstIndex,
+            int32_t const vertexOffset,
+            uint32_t const firstInstance);
+
+        /**
+         * @brief Remove all commands, retaining storage for reuse.
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of commands.
+         */
+        uint32_t getDrawCount() const {
+            return static_cast<uint32_t>(this->commands.size());
+        }
+
+        /**
+         * @brief Get the size of the command array in bytes.
+         */
+        uint64_t getSize() const {
+            return this->commands.size() * stride;
+        }
+
+        /**
+         * @brief Copy commands into a mapped, host visible buffer.
+         * @param buffer Shared pointer to the destination buffer, must be mapped.
+         * @param offset Offset within the buffer to write the commands to in bytes.
+         */
+        void write(std::shared_ptr<Buffer> const& buffer, uint64_t const offset = 0) const;
+
+        /**
+         * @brief Copy commands into a mapped staging buffer, and record a copy to a device buffer.
+         * @param commandBuffer Command buffer to record the copy into.
+         * @param stagingBuffer Shared pointer to the staging buffer, must be mapped.
+         * @param deviceBuffer Shared pointer to the destination buffer.
+         * @param offset Offset within the destination buffer to write the commands to in bytes.
+         */
+        void recordUpload(
+            std::shared_ptr<CommandBuffer> const& commandBuffer,
+            std::shared_ptr<Buffer> const& stagingBuffer,
+            std::shared_ptr<Buffer> const& deviceBuffer,
+            uint64_t const offset = 0) const;
+    };
+
+}
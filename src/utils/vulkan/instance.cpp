@@ -133,6 +133,9 @@ namespace utils::vulkan {
             requiredExtensions[i] = std::string(glfwExtensions[i]);
         }
 
+        // Needed to query and enable features of device extensions on a 1.0 instance
+        requiredExtensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+
         if (validationLayers.size() > 0) {
             requiredExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
         }
@@ -0,0 +1,110 @@
+#include "utils/vulkan/layout_cache.hpp"
+#include "utils/misc/hash.hpp"
+
+
+namespace utils::vulkan {
+
+    utils::Logger LayoutCache::log("LayoutCache");
+
+
+    bool LayoutCache::PipelineLayoutKey::operator==(PipelineLayoutKey const& other) const {
+        if (
+            this->descriptorSetLayouts != other.descriptorSetLayouts ||
+            this->pushConstantRanges.size() != other.pushConstantRanges.size()
+        ) {
+            return false;
+        }
+
+        for (unsigned i = 0; i < this->pushConstantRanges.size(); i++) {
+            auto const& a = this->pushConstantRanges[i];
+            auto const& b = other.pushConstantRanges[i];
+
+            if (a.stageFlags != b.stageFlags || a.offset != b.offset || a.size != b.size) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    std::size_t LayoutCache::PipelineLayoutKeyHash::operator()(PipelineLayoutKey const& key) const {
+        std::size_t seed = 0;
+
+        for (auto const& descriptorSetLayout : key.descriptorSetLayouts) {
+            utils::hashCombine(seed, descriptorSetLayout.get());
+        }
+
+        for (auto const& range : key.pushConstantRanges) {
+            utils::hashCombine(seed, range.stageFlags);
+            utils::hashCombine(seed, range.offset);
+            utils::hashCombine(seed, range.size);
+        }
+
+        return seed;
+    }
+
+
+    LayoutCache::LayoutCache(std::shared_ptr<DeviceHandle> const& vkDeviceHandle) :
+        vkDeviceHandle(vkDeviceHandle) {}
+
+
+    std::shared_ptr<DescriptorSetLayout> LayoutCache::getDescriptorSetLayout(DescriptorSetLayoutConfig const& config) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto const existing = this->descriptorSetLayouts.find(config);
+
+        if (existing != this->descriptorSetLayouts.end()) {
+            return existing->second;
+        }
+
+        auto const descriptorSetLayout = std::make_shared<DescriptorSetLayout>(this->vkDeviceHandle, config);
+        this->descriptorSetLayouts.emplace(config, descriptorSetLayout);
+
+        INFO(log) << "Cached descriptor set layout " << this->descriptorSetLayouts.size() << std::endl;
+        return descriptorSetLayout;
+    }
+
+
+    std::shared_ptr<PipelineLayout> LayoutCache::getPipelineLayout(PipelineLayoutConfig const& config) {
+        PipelineLayoutKey key;
+        key.pushConstantRanges = config.pushConstantRanges;
+
+        for (auto const& descriptorSetLayout : config.descriptorSets) {
+            key.descriptorSetLayouts.push_back(descriptorSetLayout->getHandle());
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto const existing = this->pipelineLayouts.find(key);
+
+        if (existing != this->pipelineLayouts.end()) {
+            return existing->second;
+        }
+
+        auto const pipelineLayout = std::make_shared<PipelineLayout>(this->vkDeviceHandle, config);
+        this->pipelineLayouts.emplace(std::move(key), pipelineLayout);
+
+        INFO(log) << "Cached pipeline layout " << this->pipelineLayouts.size() << std::endl;
+        return pipelineLayout;
+    }
+
+
+    std::shared_ptr<PipelineLayout> LayoutCache::getPipelineLayout(ShaderReflection const& reflection) {
+        PipelineLayoutConfig config;
+
+        // Sets below the highest one used still need a (possibly empty) layout
+        for (uint32_t set = 0; set < reflection.getDescriptorSetCount(); set++) {
+            config.addDescriptorSet(this->getDescriptorSetLayout(reflection.getDescriptorSetLayoutConfig(set)));
+        }
+
+        config.pushConstantRanges = reflection.getPushConstantRanges();
+        return this->getPipelineLayout(config);
+    }
+
+
+    void LayoutCache::clear() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->descriptorSetLayouts.clear();
+        this->pipelineLayouts.clear();
+    }
+
+}
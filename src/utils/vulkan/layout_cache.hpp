@@ -0,0 +1,79 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/descriptor_set_layout.hpp"
+#include "utils/vulkan/pipeline_layout.hpp"
+#include "utils/vulkan/shader_reflection.hpp"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Shares descriptor set layouts and pipeline layouts with identical contents.
+     * Pipelines built from the same layouts have compatible pipeline layouts, so descriptor
+     * sets bound for one stay bound when switching to another.
+     */
+    class LayoutCache {
+    private:
+        static utils::Logger log;
+
+        struct DescriptorSetLayoutConfigHash {
+            std::size_t operator()(DescriptorSetLayoutConfig const& config) const {
+                return config.hash();
+            }
+        };
+
+        struct PipelineLayoutKey {
+            std::vector<std::shared_ptr<DescriptorSetLayoutHandle>> descriptorSetLayouts;
+            std::vector<VkPushConstantRange> pushConstantRanges;
+
+            bool operator==(PipelineLayoutKey const& other) const;
+        };
+
+        struct PipelineLayoutKeyHash {
+            std::size_t operator()(PipelineLayoutKey const& key) const;
+        };
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+        mutable std::mutex mutex;
+        std::unordered_map<DescriptorSetLayoutConfig, std::shared_ptr<DescriptorSetLayout>, DescriptorSetLayoutConfigHash> descriptorSetLayouts;
+        std::unordered_map<PipelineLayoutKey, std::shared_ptr<PipelineLayout>, PipelineLayoutKeyHash> pipelineLayouts;
+
+    public:
+        LayoutCache(std::shared_ptr<DeviceHandle> const& vkDeviceHandle);
+
+        /**
+         * @brief Get a descriptor set layout, creating it if no identical layout exists.
+         * @param config Descriptor set layout config, binding order matters.
+         * @return Shared pointer to descriptor set layout object.
+         */
+        std::shared_ptr<DescriptorSetLayout> getDescriptorSetLayout(DescriptorSetLayoutConfig const& config);
+
+        /**
+         * @brief Get a pipeline layout, creating it if no identical layout exists.
+         * @param config Pipeline layout config object.
+         * @return Shared pointer to pipeline layout object.
+         */
+        std::shared_ptr<PipelineLayout> getPipelineLayout(PipelineLayoutConfig const& config);
+
+        /**
+         * @brief Get the pipeline layout matching a reflected shader interface.
+         * @param reflection Reflection of every stage of the pipeline, merged.
+         * @return Shared pointer to pipeline layout object.
+         */
+        std::shared_ptr<PipelineLayout> getPipelineLayout(ShaderReflection const& reflection);
+
+        /**
+         * @brief Release the cache's references to all layouts.
+         */
+        void clear();
+    };
+
+}
@@ -43,6 +43,7 @@ namespace utils::vulkan {
 
     std::optional<QueueFamily> PhysicalDevice::selectQueueFamily(QueueConstraints const& queueConstraints) const {
         auto const queueFamilyProperties = getQueueFamilyProperties();
+        std::optional<QueueFamily> fallbackFamily;
 
         for (unsigned i = 0; i < queueFamilyProperties.size(); i++) {
             auto const& properties = queueFamilyProperties[i];
@@ -66,10 +67,19 @@ namespace utils::vulkan {
                 }
             }
 
+            // Prefer families without the avoided flags, but keep the first match in case there are none
+            if ((properties.queueFlags & queueConstraints.avoidedFlags) != 0) {
+                if (!fallbackFamily) {
+                    fallbackFamily.emplace(i, properties);
+                }
+
+                continue;
+            }
+
             return QueueFamily(i, properties);
         }
 
-        return std::optional<QueueFamily>();
+        return fallbackFamily;
     }
 
 
@@ -159,9 +169,10 @@ namespace utils::vulkan {
 
     std::shared_ptr<Device> PhysicalDevice::createLogicalDevice(
         QueuePlan const& queuePlan,
-        std::vector<std::string> const& deviceExtensions
+        std::vector<std::string> const& deviceExtensions,
+        std::vector<std::string> const& optionalExtensions
     ) const {
-        std::map<std::string, uint32_t> queueFamilyIndexMap;
+        std::map<std::string, QueueRequest> queueRequests;
 
         for (auto const& entry : queuePlan.queues) {
             auto const& queueName = entry.first;
@@ -173,10 +184,27 @@ namespace utils::vulkan {
                 throw std::runtime_error("Device does not support required queues.");
             }
 
-            queueFamilyIndexMap[queueName] = queueFamily.value().index;
+            if (queueConstraints.priority < 0.0f || queueConstraints.priority > 1.0f) {
+                throw std::runtime_error("Queue priority must be between 0.0 and 1.0.");
+            }
+
+            queueRequests[queueName] = {
+                queueFamily.value().index,
+                queueFamily.value().properties.queueCount,
+                queueConstraints.priority};
+        }
+
+        auto enabledExtensions = deviceExtensions;
+
+        for (auto const& extension : optionalExtensions) {
+            if (checkExtensionSupport({extension})) {
+                enabledExtensions.push_back(extension);
+            } else {
+                INFO(log) << "Optional device extension " << extension << " is not supported." << std::endl;
+            }
         }
 
-        return std::make_shared<Device>(this->vkInstanceHandle, this->vkPhysicalDevice, queueFamilyIndexMap, deviceExtensions);
+        return std::make_shared<Device>(this->vkInstanceHandle, this->vkPhysicalDevice, queueRequests, enabledExtensions);
     }
 
 
@@ -92,10 +92,12 @@ namespace utils::vulkan {
          * @brief Create a logical device from this physical device.
          * @param queueFamily QueueFamily object specifying family to use.
          * @param deviceExtensions Vector of strings containing the names of required extensions, defaults to empty vector.
+         * @param optionalExtensions Vector of strings containing the names of extensions to enable if supported.
          */
         std::shared_ptr<utils::vulkan::Device> createLogicalDevice(
             QueuePlan const& queuePlan,
-            std::vector<std::string> const& deviceExtensions) const;
+            std::vector<std::string> const& deviceExtensions,
+            std::vector<std::string> const& optionalExtensions = std::vector<std::string>()) const;
 
         /**
          * @brief Get information about swap chain support.
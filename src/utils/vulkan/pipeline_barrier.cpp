@@ -0,0 +1,263 @@
+#include "utils/vulkan/pipeline_barrier.hpp"
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Stages and accesses associated with an image in a given layout.
+     */
+    AccessScope getImageLayoutScope(VkImageLayout const layout) {
+        switch (layout) {
+            case VK_IMAGE_LAYOUT_UNDEFINED:
+                return {VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0};
+
+            case VK_IMAGE_LAYOUT_PREINITIALIZED:
+                return {VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_WRITE_BIT};
+
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+                return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT};
+
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+                return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT};
+
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+                return {
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT};
+
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+                return {
+                    VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+                return {
+                    VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT};
+
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+                return {
+                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_ACCESS_SHADER_READ_BIT};
+
+            case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+                return {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0};
+
+            default:
+                return {VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT};
+        }
+    }
+
+
+    AccessScope getImageLayoutSourceScope(VkImageLayout const layout) {
+        // Presentation engine reads are ordered by the acquire semaphore, which is
+        // waited on at the color attachment output stage.
+        if (layout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR) {
+            return {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0};
+        }
+
+        // Only writes need to be made available, reads can be left out of the source scope
+        AccessScope scope = getImageLayoutScope(layout);
+        scope.access &= writeAccessFlags;
+        return scope;
+    }
+
+
+    AccessScope getImageLayoutDestinationScope(VkImageLayout const layout) {
+        return getImageLayoutScope(layout);
+    }
+
+
+    VkPipelineStageFlags getQueueSupportedStages(VkQueueFlags const queueFlags) {
+        VkPipelineStageFlags stages =
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT |
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
+            VK_PIPELINE_STAGE_HOST_BIT |
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        // Graphics and compute queues implicitly support transfers
+        if ((queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT)) != 0) {
+            stages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+        }
+
+        if ((queueFlags & VK_QUEUE_COMPUTE_BIT) != 0) {
+            stages |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        }
+
+        if ((queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0) {
+            stages |=
+                VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT |
+                VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT |
+                VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT |
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
+        }
+
+        return stages;
+    }
+
+
+    AccessScope restrictScopeToStages(AccessScope const& scope, VkPipelineStageFlags const supportedStages) {
+        AccessScope restricted {scope.stages & supportedStages, scope.access};
+
+        // Nothing left to synchronize; record() falls back to TOP/BOTTOM_OF_PIPE which has no accesses
+        if (restricted.stages == 0) {
+            restricted.access = 0;
+            return restricted;
+        }
+
+        // Accesses which only happen in graphics stages
+        if ((supportedStages & VK_PIPELINE_STAGE_VERTEX_INPUT_BIT) == 0) {
+            restricted.access &= ~(
+                VK_ACCESS_INDEX_READ_BIT |
+                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
+                VK_ACCESS_INPUT_ATTACHMENT_READ_BIT |
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        }
+
+        // Transfer only queues run no shaders
+        if ((supportedStages & (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT)) == 0) {
+            restricted.access &= ~(
+                VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+                VK_ACCESS_UNIFORM_READ_BIT |
+                VK_ACCESS_SHADER_READ_BIT |
+                VK_ACCESS_SHADER_WRITE_BIT);
+        }
+
+        return restricted;
+    }
+
+
+    PipelineBarrier& PipelineBarrier::addMemoryBarrier(AccessScope const& unrestrictedSrc, AccessScope const& unrestrictedDst) {
+        auto const src = restrictScopeToStages(unrestrictedSrc, this->supportedStages);
+        auto const dst = restrictScopeToStages(unrestrictedDst, this->supportedStages);
+
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = src.access;
+        barrier.dstAccessMask = dst.access;
+
+        this->memoryBarriers.push_back(barrier);
+        this->srcStageMask |= src.stages;
+        this->dstStageMask |= dst.stages;
+
+        return *this;
+    }
+
+
+    PipelineBarrier& PipelineBarrier::addBufferBarrier(
+        std::shared_ptr<Buffer> const& buffer,
+        AccessScope const& src,
+        AccessScope const& dst,
+        uint64_t const offset,
+        uint64_t const size,
+        uint32_t const srcQueueFamilyIndex,
+        uint32_t const dstQueueFamilyIndex
+    ) {
+        return this->addBufferBarrier(
+            buffer->getHandle()->vk, src, dst, offset, size, srcQueueFamilyIndex, dstQueueFamilyIndex);
+    }
+
+
+    PipelineBarrier& PipelineBarrier::addBufferBarrier(
+        VkBuffer const buffer,
+        AccessScope const& unrestrictedSrc,
+        AccessScope const& unrestrictedDst,
+        uint64_t const offset,
+        uint64_t const size,
+        uint32_t const srcQueueFamilyIndex,
+        uint32_t const dstQueueFamilyIndex
+    ) {
+        auto const src = restrictScopeToStages(unrestrictedSrc, this->supportedStages);
+        auto const dst = restrictScopeToStages(unrestrictedDst, this->supportedStages);
+
+        VkBufferMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.buffer = buffer;
+        barrier.offset = offset;
+        barrier.size = size;
+        barrier.srcAccessMask = src.access;
+        barrier.dstAccessMask = dst.access;
+        barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+
+        this->bufferBarriers.push_back(barrier);
+        this->srcStageMask |= src.stages;
+        this->dstStageMask |= dst.stages;
+
+        return *this;
+    }
+
+
+    PipelineBarrier& PipelineBarrier::addImageBarrier(
+        VkImageMemoryBarrier const& barrier,
+        VkPipelineStageFlags const srcStages,
+        VkPipelineStageFlags const dstStages
+    ) {
+        auto const src = restrictScopeToStages({srcStages, barrier.srcAccessMask}, this->supportedStages);
+        auto const dst = restrictScopeToStages({dstStages, barrier.dstAccessMask}, this->supportedStages);
+
+        VkImageMemoryBarrier& restrictedBarrier = this->imageBarriers.emplace_back(barrier);
+        restrictedBarrier.srcAccessMask = src.access;
+        restrictedBarrier.dstAccessMask = dst.access;
+
+        this->srcStageMask |= src.stages;
+        this->dstStageMask |= dst.stages;
+
+        return *this;
+    }
+
+
+    PipelineBarrier& PipelineBarrier::addImageBarrier(VkImageMemoryBarrier const& barrier) {
+        auto const src = getImageLayoutSourceScope(barrier.oldLayout);
+        auto const dst = getImageLayoutDestinationScope(barrier.newLayout);
+
+        VkImageMemoryBarrier completeBarrier = barrier;
+        completeBarrier.srcAccessMask = src.access;
+        completeBarrier.dstAccessMask = dst.access;
+
+        return this->addImageBarrier(completeBarrier, src.stages, dst.stages);
+    }
+
+
+    void PipelineBarrier::clear() {
+        this->srcStageMask = 0;
+        this->dstStageMask = 0;
+        this->dependencyFlags = 0;
+        this->memoryBarriers.clear();
+        this->bufferBarriers.clear();
+        this->imageBarriers.clear();
+    }
+
+
+    void PipelineBarrier::record(VkCommandBuffer const commandBuffer) const {
+        if (this->isEmpty()) {
+            return;
+        }
+
+        // Stage masks of zero are not permitted, fall back to the no-op stages
+        VkPipelineStageFlags const srcStages = this->srcStageMask != 0 ? this->srcStageMask : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        VkPipelineStageFlags const dstStages = this->dstStageMask != 0 ? this->dstStageMask : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            srcStages,
+            dstStages,
+            this->dependencyFlags,
+            static_cast<uint32_t>(this->memoryBarriers.size()), this->memoryBarriers.data(),
+            static_cast<uint32_t>(this->bufferBarriers.size()), this->bufferBarriers.data(),
+            static_cast<uint32_t>(this->imageBarriers.size()), this->imageBarriers.data());
+    }
+
+}
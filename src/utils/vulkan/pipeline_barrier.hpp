@@ -0,0 +1,167 @@
+#pragma once
+
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/buffer.hpp"
+#include "utils/vulkan/resource_state.hpp"
+
+#include "vulkan/vulkan.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Get the scope of work which may have used an image in a layout.
+     * Used for the source half of a layout transition.
+     * @param layout The layout the image is leaving.
+     * @return Stages and accesses which must complete before the transition.
+     */
+    AccessScope getImageLayoutSourceScope(VkImageLayout const layout);
+
+    /**
+     * @brief Get the scope of work which may use an image in a layout.
+     * Used for the destination half of a layout transition.
+     * @param layout The layout the image is entering.
+     * @return Stages and accesses which must wait for the transition.
+     */
+    AccessScope getImageLayoutDestinationScope(VkImageLayout const layout);
+
+    /**
+     * @brief Get the pipeline stages which commands recorded for a queue family may use.
+     * @param queueFlags Capabilities of the queue family (e.g. VK_QUEUE_COMPUTE_BIT).
+     * @return Mask of every stage supported by the queue family.
+     */
+    VkPipelineStageFlags getQueueSupportedStages(VkQueueFlags const queueFlags);
+
+    /**
+     * @brief Remove the stages a queue family doesn't support from a scope, along with accesses only those stages perform.
+     * @param scope Scope to restrict.
+     * @param supportedStages Stages supported by the queue family, see getQueueSupportedStages.
+     * @return The restricted scope.
+     */
+    AccessScope restrictScopeToStages(AccessScope const& scope, VkPipelineStageFlags const supportedStages);
+
+
+    /**
+     * @brief Collects memory, buffer and image barriers so they can be recorded
+     * with a single call to CommandBuffer::pipelineBarrier.
+     * Stage masks of the individual barriers are combined. Storage is retained across
+     * calls to clear(), so a long lived instance does not allocate in steady state.
+     * Resource states are tracked independently of queues, so barriers may name stages the recording
+     * queue doesn't support. These are removed if the supported stages are set.
+     */
+    class PipelineBarrier {
+    private:
+        VkPipelineStageFlags supportedStages = ~VkPipelineStageFlags(0);
+        VkPipelineStageFlags srcStageMask = 0;
+        VkPipelineStageFlags dstStageMask = 0;
+        VkDependencyFlags dependencyFlags = 0;
+
+        std::vector<VkMemoryBarrier> memoryBarriers;
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+
+    public:
+        /**
+         * @brief Restrict barriers added from now on to the stages of the queue family they are recorded for.
+         * Kept across calls to clear().
+         * @param stages Stages supported by the queue family, see getQueueSupportedStages.
+         */
+        PipelineBarrier& setSupportedStages(VkPipelineStageFlags const stages) {
+            this->supportedStages = stages;
+            return *this;
+        }
+
+        /**
+         * @brief Add a global memory barrier.
+         * @param src Stages and accesses which must complete before the barrier.
+         * @param dst Stages and accesses which must wait for the barrier.
+         */
+        PipelineBarrier& addMemoryBarrier(AccessScope const& src, AccessScope const& dst);
+
+        /**
+         * @brief Add a buffer memory barrier.
+         * @param buffer Shared pointer to the buffer.
+         * @param src Stages and accesses which must complete before the barrier.
+         * @param dst Stages and accesses which must wait for the barrier.
+         * @param offset Offset of the affected range in bytes.
+         * @param size Size of the affected range in bytes.
+         * @param srcQueueFamilyIndex Queue family releasing ownership (for ownership transfers).
+         * @param dstQueueFamilyIndex Queue family acquiring ownership (for ownership transfers).
+         */
+        PipelineBarrier& addBufferBarrier(
+            std::shared_ptr<Buffer> const& buffer,
+            AccessScope const& src,
+            AccessScope const& dst,
+            uint64_t const offset = 0,
+            uint64_t const size = VK_WHOLE_SIZE,
+            uint32_t const srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            uint32_t const dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED);
+
+        /**
+         * @brief Add a buffer memory barrier for a raw buffer handle.
+         * @param buffer Raw handle of the buffer.
+         * @param src Stages and accesses which must complete before the barrier.
+         * @param dst Stages and accesses which must wait for the barrier.
+         * @param offset Offset of the affected range in bytes.
+         * @param size Size of the affected range in bytes.
+         * @param srcQueueFamilyIndex Queue family releasing ownership (for ownership transfers).
+         * @param dstQueueFamilyIndex Queue family acquiring ownership (for ownership transfers).
+         */
+        PipelineBarrier& addBufferBarrier(
+            VkBuffer const buffer,
+            AccessScope const& src,
+            AccessScope const& dst,
+            uint64_t const offset = 0,
+            uint64_t const size = VK_WHOLE_SIZE,
+            uint32_t const srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            uint32_t const dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED);
+
+        /**
+         * @brief Add an image memory barrier with explicit stage masks.
+         * @param barrier Image memory barrier, access masks should already be set.
+         * @param srcStages Stages which must complete before the barrier.
+         * @param dstStages Stages which must wait for the barrier.
+         */
+        PipelineBarrier& addImageBarrier(
+            VkImageMemoryBarrier const& barrier,
+            VkPipelineStageFlags const srcStages,
+            VkPipelineStageFlags const dstStages);
+
+        /**
+         * @brief Add an image memory barrier, deriving stage and access masks from its layouts.
+         * @param barrier Image memory barrier describing a layout transition.
+         */
+        PipelineBarrier& addImageBarrier(VkImageMemoryBarrier const& barrier);
+
+        /**
+         * @brief Set dependency flags (e.g. VK_DEPENDENCY_BY_REGION_BIT).
+         * @param flags Flags to add.
+         */
+        PipelineBarrier& setDependencyFlags(VkDependencyFlags const flags) {
+            this->dependencyFlags |= flags;
+            return *this;
+        }
+
+        /**
+         * @brief Check whether any barriers have been added.
+         */
+        bool isEmpty() const {
+            return this->memoryBarriers.empty() && this->bufferBarriers.empty() && this->imageBarriers.empty();
+        }
+
+        /**
+         * @brief Remove all barriers, retaining storage for reuse.
+         */
+        void clear();
+
+        /**
+         * @brief Record the collected barriers into a command buffer.
+         * @param commandBuffer Raw handle of the command buffer to record into.
+         */
+        void record(VkCommandBuffer const commandBuffer) const;
+    };
+
+}
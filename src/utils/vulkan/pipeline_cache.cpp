@@ -0,0 +1,100 @@
+#include "utils/vulkan/pipeline_cache.hpp"
+#include "utils/misc/file.hpp"
+
+#include <cstring>
+
+
+namespace utils::vulkan {
+
+    utils::Logger PipelineCache::log("PipelineCache");
+
+
+    PipelineCache::PipelineCache(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        VkPhysicalDeviceProperties const& properties,
+        std::filesystem::path const& path
+    ) :
+        HandleWrapper<PipelineCacheHandle>(std::make_shared<PipelineCacheHandle>(vkDeviceHandle)),
+        vkDeviceHandle(vkDeviceHandle)
+    {
+        std::vector<char> initialData;
+
+        if (!path.empty() && std::filesystem::is_regular_file(path)) {
+            initialData = readBinaryFile(path);
+
+            if (!isCompatible(initialData, properties)) {
+                INFO(log) << "Ignoring pipeline cache '" << std::string(path) << "', it was created by a different device or driver." << std::endl;
+                initialData.clear();
+            }
+        }
+
+        if (initialData.empty()) {
+            INFO(log) << "Creating empty pipeline cache." << std::endl;
+        } else {
+            INFO(log) << "Creating pipeline cache from '" << std::string(path) << "' (" << initialData.size() << " bytes)." << std::endl;
+        }
+
+        VkPipelineCacheCreateInfo createInfo {};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.data();
+
+        if (vkCreatePipelineCache(this->vkDeviceHandle->vk, &createInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline cache.");
+        }
+
+        this->loadedDataSize = initialData.size();
+    }
+
+
+    bool PipelineCache::isCompatible(std::vector<char> const& data, VkPhysicalDeviceProperties const& properties) {
+        // Header layout defined by VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+        struct {
+            uint32_t headerSize;
+            uint32_t headerVersion;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+        } header;
+
+        if (data.size() < sizeof(header)) {
+            return false;
+        }
+
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        return
+            header.headerSize >= sizeof(header) &&
+            header.headerSize <= data.size() &&
+            header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header.vendorID == properties.vendorID &&
+            header.deviceID == properties.deviceID &&
+            std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+
+    std::vector<char> PipelineCache::getData() const {
+        size_t dataSize = 0;
+
+        if (vkGetPipelineCacheData(this->vkDeviceHandle->vk, this->vkHandle->vk, &dataSize, nullptr) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to get pipeline cache size.");
+        }
+
+        std::vector<char> data(dataSize);
+
+        if (vkGetPipelineCacheData(this->vkDeviceHandle->vk, this->vkHandle->vk, &dataSize, data.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to get pipeline cache data.");
+        }
+
+        data.resize(dataSize);
+        return data;
+    }
+
+
+    void PipelineCache::save(std::filesystem::path const& path) const {
+        auto const data = this->getData();
+        writeBinaryFile(path, data);
+        INFO(log) << "Saved pipeline cache to '" << std::string(path) << "' (" << data.size() << " bytes)." << std::endl;
+    }
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+
+#include <filesystem>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Wrapper for VkPipelineCache which can be persisted to disk.
+     * Saved data is only reused if its header matches the vendor, device and pipeline cache
+     * UUID of the current physical device, otherwise the cache starts out empty.
+     */
+    class PipelineCache : public HandleWrapper<PipelineCacheHandle> {
+    private:
+        static utils::Logger log;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+        size_t loadedDataSize = 0;
+
+        /**
+         * @brief Check that saved cache data was produced by a compatible device and driver.
+         * @param data Saved pipeline cache data.
+         * @param properties Properties of the device the cache will be used with.
+         * @return True if the data can be used to initialize the cache.
+         */
+        static bool isCompatible(std::vector<char> const& data, VkPhysicalDeviceProperties const& properties);
+
+    public:
+        /**
+         * @brief Create a pipeline cache, seeding it with saved data if available.
+         * @param vkDeviceHandle Shared pointer to device handle.
+         * @param properties Properties of the physical device the cache will be used with.
+         * @param path Path to saved cache data (optional, missing files are ignored).
+         */
+        PipelineCache(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            VkPhysicalDeviceProperties const& properties,
+            std::filesystem::path const& path = std::filesystem::path());
+
+        /**
+         * @brief Check whether the cache was seeded with saved data.
+         */
+        bool isWarm() const {
+            return this->loadedDataSize != 0;
+        }
+
+        /**
+         * @brief Get the current contents of the cache.
+         * @return Vector of chars containing the cache data, including its header.
+         */
+        std::vector<char> getData() const;
+
+        /**
+         * @brief Write the current contents of the cache to disk.
+         * The file is replaced atomically, so an interrupted save leaves the old data intact.
+         * @param path Path to write the cache data to.
+         */
+        void save(std::filesystem::path const& path) const;
+    };
+
+}
@@ -25,8 +25,8 @@ namespace utils::vulkan {
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(config.descriptorSets.size());
         pipelineLayoutInfo.pSetLayouts = descriptorSets;
-        pipelineLayoutInfo.pushConstantRangeCount = 0;      // Optional/Todo
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;   // Optional/Todo
+        pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(config.pushConstantRanges.size());
+        pipelineLayoutInfo.pPushConstantRanges = config.pushConstantRanges.data();
 
         if (vkCreatePipelineLayout(this->vkDeviceHandle->vk, &pipelineLayoutInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
             throw std::runtime_error("failed to create pipeline layout.");
@@ -12,6 +12,7 @@ namespace utils::vulkan {
 
     struct PipelineLayoutConfig {
         std::vector<std::shared_ptr<DescriptorSetLayout>> descriptorSets;
+        std::vector<VkPushConstantRange> pushConstantRanges;
 
         /**
          * @brief Add a descriptor set to the configuration.
@@ -20,6 +21,35 @@ namespace utils::vulkan {
         void addDescriptorSet(std::shared_ptr<DescriptorSetLayout> const& descriptorSet) {
             descriptorSets.push_back(descriptorSet);
         }
+
+        /**
+         * @brief Add a push constant range to the configuration.
+         * @param stageFlags Shader stages which access the range.
+         * @param offset Offset of the range in bytes, must be a multiple of 4.
+         * @param size Size of the range in bytes, must be a multiple of 4.
+         */
+        void addPushConstantRange(VkShaderStageFlags const stageFlags, uint32_t const offset, uint32_t const size) {
+            if (offset % 4 != 0 || size % 4 != 0) {
+                throw std::runtime_error("Failed to add push constant range: Offset and size must be multiples of 4.");
+            }
+
+            VkPushConstantRange range {};
+            range.stageFlags = stageFlags;
+            range.offset = offset;
+            range.size = size;
+
+            pushConstantRanges.push_back(range);
+        }
+
+        /**
+         * @brief Add a push constant range sized to hold a value of type T.
+         * @param stageFlags Shader stages which access the range.
+         * @param offset Offset of the range in bytes, must be a multiple of 4.
+         */
+        template<typename T>
+        void addPushConstantRange(VkShaderStageFlags const stageFlags, uint32_t const offset = 0) {
+            addPushConstantRange(stageFlags, offset, sizeof(T));
+        }
     };
 
 
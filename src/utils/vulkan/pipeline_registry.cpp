@@ -0,0 +1,189 @@
+#include "utils/vulkan/pipeline_registry.hpp"
+#include "utils/misc/hash.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+
+namespace utils::vulkan {
+
+    utils::Logger PipelineRegistry::log("PipelineRegistry");
+
+
+    std::size_t PipelineRegistry::GraphicsPipelineKeyHash::operator()(GraphicsPipelineKey const& key) const {
+        std::size_t seed = key.config.hash();
+        utils::hashCombine(seed, key.vkPipelineLayoutHandle.get());
+        utils::hashCombine(seed, key.vkRenderPassHandle.get());
+        utils::hashCombine(seed, key.parts);
+        return seed;
+    }
+
+
+    PipelineRegistry::PipelineRegistry(
+        std::shared_ptr<Device> const& device,
+        utils::ThreadPool * const optimizeThreadPool
+    ) :
+        device(device),
+        optimizeThreadPool(optimizeThreadPool) {}
+
+
+    PipelineRegistry::~PipelineRegistry() {
+        this->waitForOptimizations();
+    }
+
+
+    std::shared_ptr<GraphicsPipelineLibrary> PipelineRegistry::getLibrary(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        std::shared_ptr<RenderPass> const& renderPass,
+        GraphicsPipelineConfig const& config,
+        VkGraphicsPipelineLibraryFlagsEXT const parts
+    ) {
+        GraphicsPipelineKey key {
+            pipelineLayout != nullptr ? pipelineLayout->getHandle() : nullptr,
+            renderPass != nullptr ? renderPass->getHandle() : nullptr,
+            GraphicsPipelineLibrary::getPartConfig(config, parts),
+            parts
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            auto const existing = this->libraries.find(key);
+
+            if (existing != this->libraries.end()) {
+                return existing->second;
+            }
+        }
+
+        auto const library = this->device->createGraphicsPipelineLibrary(pipelineLayout, renderPass, key.config, parts);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->libraries.emplace(std::move(key), library).first->second;
+    }
+
+
+    std::vector<std::shared_ptr<GraphicsPipelineLibrary>> PipelineRegistry::getLibraries(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        std::shared_ptr<RenderPass> const& renderPass,
+        GraphicsPipelineConfig const& config
+    ) {
+        // Vertex input needs neither layout nor render pass, fragment output doesn't need the layout
+        return {
+            this->getLibrary(nullptr, nullptr, config, VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT),
+            this->getLibrary(pipelineLayout, renderPass, config, VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT),
+            this->getLibrary(pipelineLayout, renderPass, config, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT),
+            this->getLibrary(nullptr, renderPass, config, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT)
+        };
+    }
+
+
+    void PipelineRegistry::queueOptimization(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        std::shared_ptr<RenderPass> const& renderPass,
+        GraphicsPipelineKey const& key,
+        std::vector<std::shared_ptr<GraphicsPipelineLibrary>> const& libraries,
+        std::shared_ptr<GraphicsPipeline> const& fastLinkedPipeline
+    ) {
+        // The destructor waits for these, so capturing this is safe
+        auto optimization = this->optimizeThreadPool->submit([=] {
+            auto const optimized = this->device->linkGraphicsPipeline(pipelineLayout, renderPass, key.config, libraries, true);
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            auto const existing = this->graphicsPipelines.find(key);
+
+            // Skip if the registry was cleared in the meantime
+            if (existing != this->graphicsPipelines.end() && existing->second == fastLinkedPipeline) {
+                existing->second = optimized;
+            }
+        });
+
+        // Drop finished optimizations so the list doesn't grow with every pipeline
+        this->optimizations.erase(
+            std::remove_if(this->optimizations.begin(), this->optimizations.end(), [](std::future<void> const& future) {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }),
+            this->optimizations.end());
+
+        this->optimizations.push_back(std::move(optimization));
+    }
+
+
+    std::shared_ptr<GraphicsPipeline> PipelineRegistry::getGraphicsPipeline(
+        std::shared_ptr<PipelineLayout> const& pipelineLayout,
+        std::shared_ptr<RenderPass> const& renderPass,
+        GraphicsPipelineConfig const& config
+    ) {
+        // Key on the state the pipeline will actually bake, so unsupported dynamic states don't split entries
+        GraphicsPipelineKey key {
+            pipelineLayout->getHandle(),
+            renderPass->getHandle(),
+            config.resolveDynamicStates(this->device->getHandle()->functions)
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            auto const existing = this->graphicsPipelines.find(key);
+
+            if (existing != this->graphicsPipelines.end()) {
+                return existing->second;
+            }
+        }
+
+        // Compile without holding the lock so other threads can look up or create pipelines
+        std::vector<std::shared_ptr<GraphicsPipelineLibrary>> libraries;
+        std::shared_ptr<GraphicsPipeline> pipeline;
+
+        if (this->device->supportsGraphicsPipelineLibrary()) {
+            libraries = this->getLibraries(pipelineLayout, renderPass, key.config);
+            pipeline = this->device->linkGraphicsPipeline(pipelineLayout, renderPass, key.config, libraries, false);
+        } else {
+            pipeline = this->device->createGraphicsPipeline(pipelineLayout, renderPass, config);
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        // Another thread may have created the same pipeline meanwhile, keep whichever got in first
+        auto const inserted = this->graphicsPipelines.emplace(std::move(key), pipeline);
+
+        if (inserted.second) {
+            INFO(log) << "Registered graphics pipeline " << this->graphicsPipelines.size() << std::endl;
+
+            if (pipeline->isFastLinked() && this->optimizeThreadPool != nullptr) {
+                this->queueOptimization(pipelineLayout, renderPass, inserted.first->first, libraries, pipeline);
+            }
+        }
+
+        return inserted.first->second;
+    }
+
+
+    void PipelineRegistry::waitForOptimizations() {
+        std::vector<std::future<void>> optimizations;
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            optimizations.swap(this->optimizations);
+        }
+
+        for (auto& optimization : optimizations) {
+            try {
+                optimization.get();
+            } catch (std::exception const& e) {
+                WARN(log) << "Optimized pipeline link failed, keeping fast-linked pipeline: " << e.what() << std::endl;
+            }
+        }
+    }
+
+
+    std::size_t PipelineRegistry::size() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->graphicsPipelines.size();
+    }
+
+
+    void PipelineRegistry::clear() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->graphicsPipelines.clear();
+        this->libraries.clear();
+    }
+
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/misc/thread_pool.hpp"
+#include "utils/vulkan/device.hpp"
+#include "utils/vulkan/graphics_pipeline.hpp"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Deduplicates graphics pipelines by their full creation state.
+     * Requesting a pipeline with the same layout, render pass and config as an existing one
+     * returns the existing pipeline, so pipeline pointers can be used directly as sort keys.
+     * Render passes are matched by handle rather than by compatibility.
+     *
+     * When the device supports graphics pipeline libraries, pipelines are fast-linked from
+     * separately cached parts (vertex input, pre-rasterization, fragment shader, fragment output),
+     * so a new combination of known parts costs a link rather than a full compile. If an
+     * optimization thread pool is given, an optimized pipeline is then linked in the background
+     * and replaces the fast-linked one in the registry once ready.
+     */
+    class PipelineRegistry {
+    private:
+        static utils::Logger log;
+
+        struct GraphicsPipelineKey {
+            std::shared_ptr<PipelineLayoutHandle> vkPipelineLayoutHandle;
+            std::shared_ptr<RenderPassHandle> vkRenderPassHandle;
+            GraphicsPipelineConfig config;
+
+            // Pipeline library parts, zero for complete pipelines
+            VkGraphicsPipelineLibraryFlagsEXT parts = 0;
+
+            bool operator==(GraphicsPipelineKey const& other) const {
+                return
+                    this->vkPipelineLayoutHandle == other.vkPipelineLayoutHandle &&
+                    this->vkRenderPassHandle == other.vkRenderPassHandle &&
+                    this->parts == other.parts &&
+                    this->config == other.config;
+            }
+        };
+
+        struct GraphicsPipelineKeyHash {
+            std::size_t operator()(GraphicsPipelineKey const& key) const;
+        };
+
+        std::shared_ptr<Device> const device;
+        utils::ThreadPool * const optimizeThreadPool;
+
+        mutable std::mutex mutex;
+        std::unordered_map<GraphicsPipelineKey, std::shared_ptr<GraphicsPipeline>, GraphicsPipelineKeyHash> graphicsPipelines;
+        std::unordered_map<GraphicsPipelineKey, std::shared_ptr<GraphicsPipelineLibrary>, GraphicsPipelineKeyHash> libraries;
+        std::vector<std::future<void>> optimizations;
+
+    private:
+        /**
+         * @brief Get a pipeline library, creating it if no library with the same part state exists.
+         */
+        std::shared_ptr<GraphicsPipelineLibrary> getLibrary(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            std::shared_ptr<RenderPass> const& renderPass,
+            GraphicsPipelineConfig const& config,
+            VkGraphicsPipelineLibraryFlagsEXT const parts);
+
+        /**
+         * @brief Get the libraries for every part of a pipeline.
+         */
+        std::vector<std::shared_ptr<GraphicsPipelineLibrary>> getLibraries(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            std::shared_ptr<RenderPass> const& renderPass,
+            GraphicsPipelineConfig const& config);
+
+        /**
+         * @brief Queue an optimized re-link of a registered fast-linked pipeline.
+         * Must be called with the registry lock held.
+         */
+        void queueOptimization(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            std::shared_ptr<RenderPass> const& renderPass,
+            GraphicsPipelineKey const& key,
+            std::vector<std::shared_ptr<GraphicsPipelineLibrary>> const& libraries,
+            std::shared_ptr<GraphicsPipeline> const& fastLinkedPipeline);
+
+    public:
+        /**
+         * @brief Construct a new pipeline registry.
+         * @param device Device to create pipelines on.
+         * @param optimizeThreadPool Thread pool for optimized re-linking of fast-linked pipelines (optional).
+         * Must outlive the registry.
+         */
+        PipelineRegistry(std::shared_ptr<Device> const& device, utils::ThreadPool * const optimizeThreadPool = nullptr);
+
+        /**
+         * @brief Waits for outstanding optimized re-links.
+         */
+        ~PipelineRegistry();
+
+        PipelineRegistry(PipelineRegistry const&) = delete;
+        PipelineRegistry& operator=(PipelineRegistry const&) = delete;
+
+        /**
+         * @brief Get a graphics pipeline, creating it if no identical pipeline exists.
+         * Safe to call from several threads, creation happens outside the registry lock.
+         * Returned pipelines may be fast-linked, look the pipeline up again later to pick up
+         * the optimized version.
+         * @param pipelineLayout Shared pointer to valid pipeline layout object.
+         * @param renderPass Shared pointer to valid render pass object.
+         * @param config Graphics pipeline config object containing pipeline details.
+         * @return Shared pointer to graphics pipeline object.
+         */
+        std::shared_ptr<GraphicsPipeline> getGraphicsPipeline(
+            std::shared_ptr<PipelineLayout> const& pipelineLayout,
+            std::shared_ptr<RenderPass> const& renderPass,
+            GraphicsPipelineConfig const& config);
+
+        /**
+         * @brief Block until all queued optimized re-links have completed.
+         */
+        void waitForOptimizations();
+
+        /**
+         * @brief Get the number of unique graphics pipelines in the registry.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Release the registry's references to all pipelines and libraries.
+         */
+        void clear();
+    };
+
+}
@@ -1,5 +1,7 @@
 #include "utils/vulkan/queue.hpp"
 
+#include <algorithm>
+
 
 namespace utils::vulkan {
 
@@ -12,12 +14,69 @@ namespace utils::vulkan {
         uint32_t const queueIndex,
         std::string const& name
     ) : vkDeviceHandle(vkDeviceHandle), name(name), queueFamilyIndex(queueFamilyIndex) {
-        INFO(log) << "Creating queue '" << name << "' family index " << queueFamilyIndex << std::endl;
+        INFO(log) << "Creating queue '" << name << "' family index " << queueFamilyIndex << " queue index " << queueIndex << std::endl;
         vkGetDeviceQueue(vkDeviceHandle->vk, queueFamilyIndex, queueIndex, &vkQueue);
+
+        if (vkDeviceHandle->functions.vkGetSemaphoreCounterValue != nullptr) {
+            this->progressSemaphore = std::make_shared<TimelineSemaphore>(vkDeviceHandle, 0);
+        }
+    }
+
+
+    uint64_t Queue::submit(SubmitBatch& batch, VkFence const fence) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->submitLocked(batch, fence);
+    }
+
+
+    uint64_t Queue::submitLocked(SubmitBatch& batch, VkFence const fence) {
+        if (batch.isEmpty() && fence == VK_NULL_HANDLE) {
+            return this->lastSubmittedValue;
+        }
+
+        VkSubmitInfo const * const batchInfos = batch.getSubmitInfos();
+
+        if (this->progressSemaphore == nullptr) {
+            if (vkQueueSubmit(this->vkQueue, batch.getSubmitCount(), batchInfos, fence) != VK_SUCCESS) {
+                throw std::runtime_error("failed to submit draw command buffer.");
+            }
+
+            return 0;
+        }
+
+        // The progress signal goes in a trailing submission of its own, so the caller's batch
+        // is left untouched. Signal operations cover all work earlier in submission order.
+        this->progressSignalValue = this->lastSubmittedValue + 1;
+
+        this->progressTimelineInfo = {};
+        this->progressTimelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        this->progressTimelineInfo.signalSemaphoreValueCount = 1;
+        this->progressTimelineInfo.pSignalSemaphoreValues = &this->progressSignalValue;
+
+        VkSubmitInfo progressInfo {};
+        progressInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        progressInfo.pNext = &this->progressTimelineInfo;
+        progressInfo.signalSemaphoreCount = 1;
+        progressInfo.pSignalSemaphores = &this->progressSemaphore->getHandle()->vk;
+
+        this->submitInfos.assign(batchInfos, batchInfos + batch.getSubmitCount());
+        this->submitInfos.push_back(progressInfo);
+
+        if (vkQueueSubmit(this->vkQueue, static_cast<uint32_t>(this->submitInfos.size()), this->submitInfos.data(), fence) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit draw command buffer.");
+        }
+
+        this->lastSubmittedValue = this->progressSignalValue;
+        return this->lastSubmittedValue;
     }
 
 
-    void Queue::submit(
+    uint64_t Queue::submit(SubmitBatch& batch, std::shared_ptr<Fence> const& fence) {
+        return this->submit(batch, fence->getHandle()->vk);
+    }
+
+
+    uint64_t Queue::submit(
         std::vector<VkPipelineStageFlags> const& waitStages,
         std::vector<std::shared_ptr<Semaphore>> const& waitSemaphores,
         std::vector<std::shared_ptr<Semaphore>> const& signalSemaphores,
@@ -28,34 +87,74 @@ namespace utils::vulkan {
             throw std::runtime_error("Unable to submit work to queue, wait stage count does not match wait semaphore count.");
         }
 
-        VkSemaphore waitSemaphoreArray[waitSemaphores.size()];
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        this->scratchBatch.clear();
+        this->scratchBatch.beginSubmit();
+
         for (unsigned i = 0; i < waitSemaphores.size(); i++) {
-            waitSemaphoreArray[i] = waitSemaphores[i]->getHandle()->vk;
+            this->scratchBatch.addWait(waitSemaphores[i], waitStages[i]);
         }
 
-        VkSemaphore signalSemaphoreArray[signalSemaphores.size()];
-        for (unsigned i = 0; i < signalSemaphores.size(); i++) {
-            signalSemaphoreArray[i] = signalSemaphores[i]->getHandle()->vk;
+        for (auto const& commandBuffer : commandBuffers) {
+            this->scratchBatch.addCommandBuffer(commandBuffer);
         }
 
-        VkCommandBuffer commandBuffersArray[commandBuffers.size()];
-        for (unsigned i = 0; i < commandBuffers.size(); i++) {
-            commandBuffersArray[i] = commandBuffers[i]->vk;
+        for (auto const& signalSemaphore : signalSemaphores) {
+            this->scratchBatch.addSignal(signalSemaphore);
         }
 
-        VkSubmitInfo submitInfo {};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.pWaitSemaphores = waitSemaphoreArray;
-        submitInfo.pWaitDstStageMask = waitStages.data();
-        submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
-        submitInfo.pCommandBuffers = commandBuffersArray;
-        submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
-        submitInfo.pSignalSemaphores = signalSemaphoreArray;
-        submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
-
-        if (vkQueueSubmit(this->vkQueue, 1, &submitInfo, inFlightFence->getHandle()->vk) != VK_SUCCESS) {
-            throw std::runtime_error("failed to submit draw command buffer.");
+        return this->submitLocked(this->scratchBatch, inFlightFence->getHandle()->vk);
+    }
+
+
+    uint64_t Queue::getLastSubmittedValue() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->lastSubmittedValue;
+    }
+
+
+    uint64_t Queue::getCompletedValue() {
+        // Querying the counter doesn't touch the VkQueue, so the lock is only held to update the cache
+        uint64_t const value = this->progressSemaphore != nullptr ? this->progressSemaphore->getValue() : 0;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->completedValue = std::max(this->completedValue, value);
+        return this->completedValue;
+    }
+
+
+    bool Queue::isComplete(uint64_t const value) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            if (value <= this->completedValue) {
+                return true;
+            }
+        }
+
+        return this->getCompletedValue() >= value;
+    }
+
+
+    void Queue::waitFor(uint64_t const value) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            if (value <= this->completedValue) {
+                return;
+            }
         }
+
+        if (this->progressSemaphore == nullptr) {
+            throw std::runtime_error("Unable to wait for queue progress, timeline semaphores are not enabled.");
+        }
+
+        // Wait without holding the lock so other threads can keep submitting
+        this->progressSemaphore->wait(value);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->completedValue = std::max(this->completedValue, value);
     }
 
 
@@ -65,20 +164,54 @@ namespace utils::vulkan {
         uint32_t const imageIndex,
         VkResult * const resultOut
     ) {
-        VkSemaphore waitSemaphoreArray[waitSemaphores.size()];
-        for (unsigned i = 0; i < waitSemaphores.size(); i++) {
-            waitSemaphoreArray[i] = waitSemaphores[i]->getHandle()->vk;
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        this->presentWaitSemaphores.clear();
+
+        for (auto const& waitSemaphore : waitSemaphores) {
+            this->presentWaitSemaphores.push_back(waitSemaphore->getHandle()->vk);
         }
 
+        this->present(
+            this->presentWaitSemaphores.data(),
+            static_cast<uint32_t>(this->presentWaitSemaphores.size()),
+            swapChain, imageIndex, resultOut);
+    }
+
+
+    void Queue::present(
+        std::shared_ptr<Semaphore> const& waitSemaphore,
+        std::shared_ptr<SwapChain> const& swapChain,
+        uint32_t const imageIndex,
+        VkResult * const resultOut
+    ) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        VkSemaphore const semaphore = waitSemaphore->getHandle()->vk;
+        this->present(&semaphore, 1, swapChain, imageIndex, resultOut);
+    }
+
+
+    void Queue::present(
+        VkSemaphore const * const waitSemaphores,
+        uint32_t const waitSemaphoreCount,
+        std::shared_ptr<SwapChain> const& swapChain,
+        uint32_t const imageIndex,
+        VkResult * const resultOut
+    ) {
         VkPresentInfoKHR presentInfo {};
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.pWaitSemaphores = waitSemaphoreArray;
-        presentInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+        presentInfo.pWaitSemaphores = waitSemaphores;
+        presentInfo.waitSemaphoreCount = waitSemaphoreCount;
         presentInfo.pSwapchains = &swapChain->getHandle()->vk;
         presentInfo.swapchainCount = 1;
         presentInfo.pImageIndices = &imageIndex;
         presentInfo.pResults = nullptr; // optional
 
         VkResult rc = vkQueuePresentKHR(this->vkQueue, &presentInfo);
+
+        if (resultOut != nullptr) {
+            *resultOut = rc;
+        }
     }
 }
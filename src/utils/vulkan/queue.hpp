@@ -3,11 +3,14 @@
 #include "utils/misc/logging.hpp"
 #include "utils/vulkan/helpers.hpp"
 #include "utils/vulkan/semaphore.hpp"
+#include "utils/vulkan/timeline_semaphore.hpp"
 #include "utils/vulkan/fence.hpp"
 #include "utils/vulkan/command_buffer.hpp"
 #include "utils/vulkan/swap_chain.hpp"
+#include "utils/vulkan/submit_batch.hpp"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 
@@ -19,14 +22,50 @@ namespace utils::vulkan {
     };
 
 
+    /**
+     * @brief Wrapper for a device queue.
+     * Submission, presentation and progress queries are internally synchronized, so a
+     * Queue may be shared between threads.
+     */
     class Queue {
     private:
         static utils::Logger log;
 
+        // VkQueue requires external synchronization, guards the handle and everything below
+        mutable std::mutex mutex;
+
         std::shared_ptr<DeviceHandle> const vkDeviceHandle;
 
         VkQueue_T * vkQueue;
 
+        // Reused by the vector based submit and present, so they don't allocate in steady state
+        SubmitBatch scratchBatch;
+        std::vector<VkSemaphore> presentWaitSemaphores;
+
+        // Progress timeline, signalled by a trailing submission on every submit to this queue
+        std::shared_ptr<TimelineSemaphore> progressSemaphore;
+        uint64_t lastSubmittedValue = 0;
+        uint64_t completedValue = 0;
+
+        uint64_t progressSignalValue = 0;
+        VkTimelineSemaphoreSubmitInfoKHR progressTimelineInfo {};
+        std::vector<VkSubmitInfo> submitInfos;
+
+        /**
+         * @brief Submit a batch, the queue mutex must be held by the caller.
+         */
+        uint64_t submitLocked(SubmitBatch& batch, VkFence const fence);
+
+        /**
+         * @brief Present with raw semaphore handles, the queue mutex must be held by the caller.
+         */
+        void present(
+            VkSemaphore const * const waitSemaphores,
+            uint32_t const waitSemaphoreCount,
+            std::shared_ptr<SwapChain> const& swapChain,
+            uint32_t const imageIndex,
+            VkResult * const resultOut);
+
     public:
         std::string const name;
         uint32_t const queueFamilyIndex;
@@ -38,21 +77,79 @@ namespace utils::vulkan {
             uint32_t const queueIndex,
             std::string const& name);
 
+        /**
+         * @brief Submit every submission in a batch with a single vkQueueSubmit.
+         * The batch is not cleared, so it can be inspected or resubmitted by the caller.
+         * @param batch Batch of submissions.
+         * @param fence Raw handle of a fence to signal on completion (optional).
+         * @return Progress value reached once the batch completes, 0 if timeline semaphores are not enabled.
+         */
+        uint64_t submit(SubmitBatch& batch, VkFence const fence = VK_NULL_HANDLE);
+
+        /**
+         * @brief Submit every submission in a batch with a single vkQueueSubmit.
+         * @param batch Batch of submissions.
+         * @param fence Shared pointer to a fence to signal on completion.
+         * @return Progress value reached once the batch completes, 0 if timeline semaphores are not enabled.
+         */
+        uint64_t submit(SubmitBatch& batch, std::shared_ptr<Fence> const& fence);
+
         /**
          * @brief Submit some work to the queue.
+         * Convenience wrapper which builds a single submission, prefer SubmitBatch on hot paths.
          * @param waitStages Vector of wait stage flags for each of the wait semaphores.
          * @param waitSemaphores Vector of semaphores that must be acquired before the buffer can execute.
          * @param signalSemaphores Vector of semaphores to signal once the operation is complete.
          * @param commandBuffers Vector of command buffers to schedule.
          * @param inFlightFence In-flight fence.
+         * @return Progress value reached once the submission completes, 0 if timeline semaphores are not enabled.
          */
-        void submit(
+        uint64_t submit(
             std::vector<VkPipelineStageFlags> const& waitStages,
             std::vector<std::shared_ptr<Semaphore>> const& waitSemaphores,
             std::vector<std::shared_ptr<Semaphore>> const& signalSemaphores,
             std::vector<std::shared_ptr<CommandBuffer>> const& commandBuffers,
             std::shared_ptr<Fence> const& inFlightFence);
 
+        /**
+         * @brief Check whether the queue tracks progress with a timeline semaphore.
+         */
+        bool hasProgressTimeline() const {
+            return this->progressSemaphore != nullptr;
+        }
+
+        /**
+         * @brief Get the timeline semaphore signalled as submissions to this queue complete.
+         * Other queues can wait on a value returned by submit() to consume this queue's results.
+         * @return Shared pointer to the semaphore, nullptr if timeline semaphores are not enabled.
+         */
+        std::shared_ptr<TimelineSemaphore> const& getProgressSemaphore() const {
+            return this->progressSemaphore;
+        }
+
+        /**
+         * @brief Get the progress value of the most recent submission.
+         */
+        uint64_t getLastSubmittedValue() const;
+
+        /**
+         * @brief Query the progress value of the most recently completed submission.
+         */
+        uint64_t getCompletedValue();
+
+        /**
+         * @brief Check whether the submission with a given progress value has completed.
+         * Does not query the device if the value is already known to be complete.
+         * @param value Progress value returned by submit().
+         */
+        bool isComplete(uint64_t const value);
+
+        /**
+         * @brief Block until the submission with a given progress value has completed.
+         * @param value Progress value returned by submit().
+         */
+        void waitFor(uint64_t const value);
+
         /**
          * @brief Return an image to the swap chain for presentation.
          * @param waitSemaphores Semaphores to wait on before executing the present operation.
@@ -65,6 +162,19 @@ namespace utils::vulkan {
             std::shared_ptr<SwapChain> const& swapChain,
             uint32_t const imageIndex,
             VkResult * const resultOut = nullptr);
+
+        /**
+         * @brief Return an image to the swap chain for presentation, waiting on a single semaphore.
+         * @param waitSemaphore Semaphore to wait on before executing the present operation.
+         * @param swapChain The swap chain to present the image to.
+         * @param imageIndex The index of the image in the swap chain to present.
+         * @param resultOut Pointer to VkResult to store result of vulkan call in.
+         */
+        void present(
+            std::shared_ptr<Semaphore> const& waitSemaphore,
+            std::shared_ptr<SwapChain> const& swapChain,
+            uint32_t const imageIndex,
+            VkResult * const resultOut = nullptr);
     };
 
 }
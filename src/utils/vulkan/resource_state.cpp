@@ -0,0 +1,61 @@
+#include "utils/vulkan/resource_state.hpp"
+
+
+namespace utils::vulkan {
+
+    bool transitionResourceState(
+        ResourceState& state,
+        AccessScope const& usage,
+        bool const layoutChange,
+        AccessScope * const srcOut
+    ) {
+        bool const writes = (usage.access & writeAccessFlags) != 0;
+
+        if (!writes && !layoutChange) {
+            bool const alreadyVisible =
+                (usage.stages & ~state.reads.stages) == 0 &&
+                (usage.access & ~state.reads.access) == 0;
+
+            // Nothing to wait for, or an earlier barrier already covered this kind of read
+            if (state.lastWrite.stages == 0 || alreadyVisible) {
+                state.reads.stages |= usage.stages;
+                state.reads.access |= usage.access;
+                return false;
+            }
+
+            *srcOut = state.lastWrite;
+            state.reads.stages |= usage.stages;
+            state.reads.access |= usage.access;
+            return true;
+        }
+
+        // Writes and layout transitions must wait for all earlier reads and writes
+        AccessScope src;
+        src.stages = state.lastWrite.stages | state.reads.stages;
+        src.access = state.lastWrite.access;
+
+        if (writes) {
+            state.lastWrite.stages = usage.stages;
+            state.lastWrite.access = usage.access & writeAccessFlags;
+            state.reads = AccessScope();
+        } else {
+            // A layout transition is itself a write, ordered before the stages of this use
+            state.lastWrite.stages = usage.stages;
+            state.lastWrite.access = 0;
+            state.reads = usage;
+        }
+
+        // First use of a resource which needs no layout change has nothing to wait for
+        if (src.stages == 0 && !layoutChange) {
+            return false;
+        }
+
+        if (src.stages == 0) {
+            src.stages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        }
+
+        *srcOut = src;
+        return true;
+    }
+
+}
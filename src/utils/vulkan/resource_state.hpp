@@ -0,0 +1,80 @@
+#pragma once
+
+#include "vulkan/vulkan.h"
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Pipeline stages and memory access types making up one side of a dependency.
+     */
+    struct AccessScope {
+        VkPipelineStageFlags stages = 0;
+        VkAccessFlags access = 0;
+    };
+
+
+    /**
+     * @brief Access flags which represent memory writes.
+     */
+    VkAccessFlags constexpr writeAccessFlags =
+        VK_ACCESS_SHADER_WRITE_BIT |
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_TRANSFER_WRITE_BIT |
+        VK_ACCESS_HOST_WRITE_BIT |
+        VK_ACCESS_MEMORY_WRITE_BIT;
+
+
+    /**
+     * @brief Synchronization state of a buffer range or image subresource.
+     * Tracks the last write, and the reads which have since been synchronized with it.
+     * State is updated at record time, so it assumes command buffers execute in the
+     * order they were recorded.
+     */
+    struct ResourceState {
+        AccessScope lastWrite;
+        AccessScope reads;
+
+        bool operator==(ResourceState const& other) const {
+            return lastWrite.stages == other.lastWrite.stages &&
+                   lastWrite.access == other.lastWrite.access &&
+                   reads.stages == other.reads.stages &&
+                   reads.access == other.reads.access;
+        }
+
+        bool operator!=(ResourceState const& other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Combine with another state, so that waiting on the result waits on both.
+         * @param other State to combine with.
+         */
+        ResourceState& operator|=(ResourceState const& other) {
+            lastWrite.stages |= other.lastWrite.stages;
+            lastWrite.access |= other.lastWrite.access;
+            reads.stages |= other.reads.stages;
+            reads.access |= other.reads.access;
+            return *this;
+        }
+    };
+
+
+    /**
+     * @brief Update resource state for a new use, and work out the barrier it needs.
+     * Read after read needs no barrier, read after write waits only for the write,
+     * and write after read needs only an execution dependency.
+     * @param state Resource state to update.
+     * @param usage Stages and accesses of the new use.
+     * @param layoutChange True if the use requires an image layout transition.
+     * @param srcOut Set to the source scope of the required barrier.
+     * @return True if a barrier is required before the new use.
+     */
+    bool transitionResourceState(
+        ResourceState& state,
+        AccessScope const& usage,
+        bool const layoutChange,
+        AccessScope * const srcOut);
+
+}
@@ -1,5 +1,8 @@
 #include "utils/vulkan/shader_module.hpp"
 #include "utils/misc/file.hpp"
+#include "utils/misc/hash.hpp"
+
+#include <cstring>
 
 
 namespace utils::vulkan {
@@ -10,23 +13,64 @@ namespace utils::vulkan {
     ShaderModule::ShaderModule(
         std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
         std::filesystem::path const& path
+    ) :
+        ShaderModule(vkDeviceHandle, readCode(path), path) {}
+
+
+    ShaderModule::ShaderModule(
+        std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+        std::vector<uint32_t> const& code,
+        std::filesystem::path const& path
     ) :
         HandleWrapper<ShaderModuleHandle>(std::make_shared<ShaderModuleHandle>(vkDeviceHandle)),
         vkDeviceHandle(vkDeviceHandle),
-        path(path)
+        path(path),
+        code(code),
+        codeHash(hashCode(code))
     {
-        INFO(log) << "Loading shader module from " << path << std::endl;
-
-        auto const shaderCode = utils::readBinaryFile(path);
+        if (path.empty()) {
+            INFO(log) << "Creating shader module from " << code.size() * sizeof(uint32_t) << " bytes of SPIR-V" << std::endl;
+        } else {
+            INFO(log) << "Loading shader module from " << path << std::endl;
+        }
 
         VkShaderModuleCreateInfo createInfo {};
         createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.codeSize = shaderCode.size();
-        createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
+        createInfo.codeSize = this->code.size() * sizeof(uint32_t);
+        createInfo.pCode = this->code.data();
 
         if (vkCreateShaderModule(this->vkDeviceHandle->vk, &createInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
             throw std::runtime_error("failed to create shader module.");
         }
     }
 
+
+    std::vector<uint32_t> ShaderModule::readCode(std::filesystem::path const& path) {
+        auto const bytes = utils::readBinaryFile(path);
+
+        if (bytes.empty() || bytes.size() % sizeof(uint32_t) != 0) {
+            throw std::runtime_error("'" + std::string(path) + "' does not contain valid SPIR-V.");
+        }
+
+        // Copy rather than cast, the byte buffer isn't guaranteed to be word aligned
+        std::vector<uint32_t> code(bytes.size() / sizeof(uint32_t));
+        std::memcpy(code.data(), bytes.data(), bytes.size());
+        return code;
+    }
+
+
+    ShaderReflection const& ShaderModule::getReflection() const {
+        // A failed attempt leaves the flag unset, so later calls throw the same error again
+        std::call_once(this->reflectionOnce, [this]() {
+            this->reflection.emplace(this->code);
+        });
+
+        return *this->reflection;
+    }
+
+
+    uint64_t ShaderModule::hashCode(std::vector<uint32_t> const& code) {
+        return utils::fnv1a(code.data(), code.size() * sizeof(uint32_t));
+    }
+
 }
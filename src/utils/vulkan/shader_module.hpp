@@ -2,10 +2,14 @@
 
 #include "utils/misc/logging.hpp"
 #include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/shader_reflection.hpp"
 
 #include <string>
 #include <memory>
 #include <filesystem>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 
 namespace utils::vulkan {
@@ -18,10 +22,68 @@ namespace utils::vulkan {
 
         std::filesystem::path const path;
 
+        // Kept so identical modules can be detected and the code inspected later
+        std::vector<uint32_t> const code;
+        uint64_t const codeHash;
+
+        // Built on first use, reflection only covers a subset of SPIR-V and must not prevent module creation
+        mutable std::once_flag reflectionOnce;
+        mutable std::optional<ShaderReflection> reflection;
+
     public:
         ShaderModule(
             std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
             std::filesystem::path const& path);
+
+        /**
+         * @brief Create a shader module from SPIR-V code in memory.
+         * @param code SPIR-V words.
+         * @param path Path the code was loaded from, if any. Only used for logging.
+         */
+        ShaderModule(
+            std::shared_ptr<DeviceHandle> const& vkDeviceHandle,
+            std::vector<uint32_t> const& code,
+            std::filesystem::path const& path = std::filesystem::path());
+
+        /**
+         * @brief Read SPIR-V code from a file.
+         * @param path Path to the spv file.
+         * @return SPIR-V words.
+         */
+        static std::vector<uint32_t> readCode(std::filesystem::path const& path);
+
+        /**
+         * @brief Hash SPIR-V code, stable between runs.
+         * @param code SPIR-V words.
+         */
+        static uint64_t hashCode(std::vector<uint32_t> const& code);
+
+        /**
+         * @brief Get the SPIR-V code the module was created from.
+         */
+        std::vector<uint32_t> const& getCode() const {
+            return this->code;
+        }
+
+        /**
+         * @brief Get the content hash of the module's SPIR-V code.
+         */
+        uint64_t getCodeHash() const {
+            return this->codeHash;
+        }
+
+        /**
+         * @brief Get the resource interface of the shader, reflecting the code on first use.
+         * Throws if the shader uses execution models or resource types reflection doesn't support.
+         */
+        ShaderReflection const& getReflection() const;
+
+        /**
+         * @brief Get the path the module was loaded from, empty if created from memory.
+         */
+        std::filesystem::path const& getPath() const {
+            return this->path;
+        }
     };
 
 }
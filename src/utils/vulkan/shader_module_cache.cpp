@@ -0,0 +1,81 @@
+#include "utils/vulkan/shader_module_cache.hpp"
+
+
+namespace utils::vulkan {
+
+    utils::Logger ShaderModuleCache::log("ShaderModuleCache");
+
+
+    ShaderModuleCache::ShaderModuleCache(std::shared_ptr<DeviceHandle> const& vkDeviceHandle) :
+        vkDeviceHandle(vkDeviceHandle) {}
+
+
+    std::shared_ptr<ShaderModule> ShaderModuleCache::getLocked(
+        std::vector<uint32_t> const& code,
+        std::filesystem::path const& path
+    ) {
+        uint64_t const codeHash = ShaderModule::hashCode(code);
+        auto const range = this->modules.equal_range(codeHash);
+
+        // Compare the code as well, so a hash collision can't hand out the wrong shader
+        for (auto it = range.first; it != range.second; it++) {
+            if (it->second->getCode() == code) {
+                return it->second;
+            }
+        }
+
+        auto const shaderModule = std::make_shared<ShaderModule>(this->vkDeviceHandle, code, path);
+        this->modules.emplace(codeHash, shaderModule);
+        return shaderModule;
+    }
+
+
+    std::shared_ptr<ShaderModule> ShaderModuleCache::get(std::filesystem::path const& path) {
+        auto const absolutePath = std::filesystem::absolute(path).lexically_normal();
+
+        std::error_code writeTimeError;
+        std::error_code fileSizeError;
+        auto const writeTime = std::filesystem::last_write_time(absolutePath, writeTimeError);
+        auto const fileSize = std::filesystem::file_size(absolutePath, fileSizeError);
+        bool const statSucceeded = !writeTimeError && !fileSizeError;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (statSucceeded) {
+            auto const existing = this->paths.find(absolutePath);
+
+            if (existing != this->paths.end() && existing->second.writeTime == writeTime && existing->second.fileSize == fileSize) {
+                return existing->second.shaderModule;
+            }
+        }
+
+        // readCode reports missing files properly, so stat errors are left to it
+        auto const shaderModule = this->getLocked(ShaderModule::readCode(absolutePath), path);
+
+        if (statSucceeded) {
+            this->paths[absolutePath] = PathEntry {writeTime, fileSize, shaderModule};
+        }
+
+        return shaderModule;
+    }
+
+
+    std::shared_ptr<ShaderModule> ShaderModuleCache::get(std::vector<uint32_t> const& code) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->getLocked(code, std::filesystem::path());
+    }
+
+
+    std::size_t ShaderModuleCache::size() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->modules.size();
+    }
+
+
+    void ShaderModuleCache::clear() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->paths.clear();
+        this->modules.clear();
+    }
+
+}
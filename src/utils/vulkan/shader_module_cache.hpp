@@ -0,0 +1,73 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+#include "utils/vulkan/shader_module.hpp"
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Shares shader modules between everything that uses the same SPIR-V.
+     * Files are remembered by path and modification time, so a repeat request for an
+     * unchanged file doesn't touch the disk. Modules are also deduplicated by content hash,
+     * so the same code loaded from different paths or from memory yields one module.
+     */
+    class ShaderModuleCache {
+    private:
+        static utils::Logger log;
+
+        struct PathEntry {
+            std::filesystem::file_time_type writeTime;
+            std::uintmax_t fileSize;
+            std::shared_ptr<ShaderModule> shaderModule;
+        };
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+        mutable std::mutex mutex;
+        std::map<std::filesystem::path, PathEntry> paths;
+        std::unordered_multimap<uint64_t, std::shared_ptr<ShaderModule>> modules;
+
+    private:
+        /**
+         * @brief Find or create the module for some code, must be called with the lock held.
+         */
+        std::shared_ptr<ShaderModule> getLocked(std::vector<uint32_t> const& code, std::filesystem::path const& path);
+
+    public:
+        ShaderModuleCache(std::shared_ptr<DeviceHandle> const& vkDeviceHandle);
+
+        /**
+         * @brief Get the shader module for an spv file, loading it if the file is new or has changed.
+         * @param path Path to the spv file.
+         * @return Shared pointer to shader module object.
+         */
+        std::shared_ptr<ShaderModule> get(std::filesystem::path const& path);
+
+        /**
+         * @brief Get the shader module for SPIR-V code in memory.
+         * @param code SPIR-V words.
+         * @return Shared pointer to shader module object.
+         */
+        std::shared_ptr<ShaderModule> get(std::vector<uint32_t> const& code);
+
+        /**
+         * @brief Get the number of unique shader modules in the cache.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Release the cache's references to all shader modules.
+         */
+        void clear();
+    };
+
+}
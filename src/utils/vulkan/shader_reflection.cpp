@@ -0,0 +1,626 @@
+#include "utils/vulkan/shader_reflection.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+namespace utils::vulkan {
+
+    namespace {
+
+        uint32_t const spirvMagic = 0x07230203;
+
+        // Subset of the SPIR-V opcodes, decorations and storage classes we care about
+        enum Op : uint32_t {
+            OpName = 5,
+            OpEntryPoint = 15,
+            OpTypeBool = 20,
+            OpTypeInt = 21,
+            OpTypeFloat = 22,
+            OpTypeVector = 23,
+            OpTypeMatrix = 24,
+            OpTypeImage = 25,
+            OpTypeSampler = 26,
+            OpTypeSampledImage = 27,
+            OpTypeArray = 28,
+            OpTypeRuntimeArray = 29,
+            OpTypeStruct = 30,
+            OpTypePointer = 32,
+            OpConstant = 43,
+            OpVariable = 59,
+            OpDecorate = 71,
+            OpMemberDecorate = 72
+        };
+
+        enum Decoration : uint32_t {
+            DecorationBlock = 2,
+            DecorationBufferBlock = 3,
+            DecorationArrayStride = 6,
+            DecorationMatrixStride = 7,
+            DecorationBuiltIn = 11,
+            DecorationLocation = 30,
+            DecorationBinding = 33,
+            DecorationDescriptorSet = 34,
+            DecorationOffset = 35
+        };
+
+        enum StorageClass : uint32_t {
+            StorageClassUniformConstant = 0,
+            StorageClassInput = 1,
+            StorageClassUniform = 2,
+            StorageClassPushConstant = 9,
+            StorageClassStorageBuffer = 12
+        };
+
+        enum Dim : uint32_t {
+            DimBuffer = 5,
+            DimSubpassData = 6
+        };
+
+        uint32_t const unset = std::numeric_limits<uint32_t>::max();
+
+
+        /**
+         * @brief Everything we track about a single SPIR-V id.
+         */
+        struct SpirvId {
+            uint32_t opcode = 0;
+            std::string name;
+
+            // Pointee, element, component, column or variable type depending on opcode
+            uint32_t typeId = 0;
+            uint32_t storageClass = 0;
+
+            // Bit width of scalars, component count of vectors, column count of matrices,
+            // length id of arrays and dimensionality of images
+            uint32_t count = 0;
+            bool isSigned = false;
+            uint32_t imageSampled = 0;
+            uint32_t constantValue = 0;
+
+            std::vector<uint32_t> members;
+
+            uint32_t set = unset;
+            uint32_t binding = unset;
+            uint32_t location = unset;
+            uint32_t arrayStride = 0;
+            bool builtIn = false;
+            bool block = false;
+            bool bufferBlock = false;
+
+            std::vector<uint32_t> memberOffsets;
+            std::vector<uint32_t> memberMatrixStrides;
+            bool memberBuiltIn = false;
+        };
+
+
+        std::string readString(std::vector<uint32_t> const& code, std::size_t const start, std::size_t const end) {
+            std::string result;
+
+            // Strings are nul terminated and packed four characters per word, low byte first
+            for (std::size_t word = start; word < end; word++) {
+                for (unsigned byte = 0; byte < 4; byte++) {
+                    char const c = static_cast<char>((code[word] >> (byte * 8)) & 0xff);
+
+                    if (c == '\0') {
+                        return result;
+                    }
+
+                    result.push_back(c);
+                }
+            }
+
+            return result;
+        }
+
+
+        void setMemberValue(std::vector<uint32_t>& values, uint32_t const member, uint32_t const value) {
+            if (values.size() <= member) {
+                values.resize(member + 1, unset);
+            }
+
+            values[member] = value;
+        }
+
+
+        VkShaderStageFlags executionModelToStage(uint32_t const executionModel) {
+            switch (executionModel) {
+                case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+                case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+                case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+                case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+                case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+                case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+                default: throw std::runtime_error("Failed to reflect shader: Unsupported execution model.");
+            }
+        }
+
+
+        /**
+         * @brief Helper which walks the type graph of a parsed module.
+         */
+        class SpirvModule {
+        public:
+            std::vector<SpirvId> ids;
+            VkShaderStageFlags stageFlags = 0;
+
+            SpirvModule(std::vector<uint32_t> const& code) {
+                if (code.size() < 5 || code[0] != spirvMagic) {
+                    throw std::runtime_error("Failed to reflect shader: Code is not SPIR-V.");
+                }
+
+                this->ids.resize(code[3]);
+
+                for (std::size_t word = 5; word < code.size();) {
+                    uint32_t const opcode = code[word] & 0xffff;
+                    uint32_t const wordCount = code[word] >> 16;
+
+                    if (wordCount == 0 || word + wordCount > code.size()) {
+                        throw std::runtime_error("Failed to reflect shader: Malformed instruction.");
+                    }
+
+                    this->parseInstruction(code, opcode, word, word + wordCount);
+                    word += wordCount;
+                }
+            }
+
+            SpirvId const& get(uint32_t const id) const {
+                if (id >= this->ids.size()) {
+                    throw std::runtime_error("Failed to reflect shader: Id out of bounds.");
+                }
+
+                return this->ids[id];
+            }
+
+            /**
+             * @brief Size of a type in bytes as laid out in a buffer.
+             */
+            uint32_t sizeOf(uint32_t const typeId, uint32_t const matrixStride = 0) const {
+                auto const& type = this->get(typeId);
+
+                switch (type.opcode) {
+                    case OpTypeBool:
+                        return 4;
+                    case OpTypeInt:
+                    case OpTypeFloat:
+                        return type.count / 8;
+                    case OpTypeVector:
+                        return type.count * this->sizeOf(type.typeId);
+                    case OpTypeMatrix:
+                        return type.count * (matrixStride != 0 ? matrixStride : this->sizeOf(type.typeId));
+                    case OpTypeArray: {
+                        uint32_t const stride = type.arrayStride != 0 ? type.arrayStride : this->sizeOf(type.typeId);
+                        return this->get(type.count).constantValue * stride;
+                    }
+                    case OpTypeStruct: {
+                        uint32_t size = 0;
+
+                        for (uint32_t i = 0; i < type.members.size(); i++) {
+                            uint32_t const offset = i < type.memberOffsets.size() && type.memberOffsets[i] != unset ? type.memberOffsets[i] : size;
+                            uint32_t const stride = i < type.memberMatrixStrides.size() && type.memberMatrixStrides[i] != unset ? type.memberMatrixStrides[i] : 0;
+                            size = std::max(size, offset + this->sizeOf(type.members[i], stride));
+                        }
+
+                        return size;
+                    }
+                    default:
+                        return 0;
+                }
+            }
+
+        private:
+            void parseInstruction(std::vector<uint32_t> const& code, uint32_t const opcode, std::size_t const start, std::size_t const end) {
+                auto const operand = [&](std::size_t const index) {
+                    if (start + 1 + index >= end) {
+                        throw std::runtime_error("Failed to reflect shader: Missing instruction operand.");
+                    }
+
+                    return code[start + 1 + index];
+                };
+
+                auto const result = [&](std::size_t const index) -> SpirvId& {
+                    uint32_t const id = operand(index);
+
+                    if (id >= this->ids.size()) {
+                        throw std::runtime_error("Failed to reflect shader: Id out of bounds.");
+                    }
+
+                    return this->ids[id];
+                };
+
+                switch (opcode) {
+                    case OpName:
+                        result(0).name = readString(code, start + 2, end);
+                        break;
+
+                    case OpEntryPoint:
+                        this->stageFlags |= executionModelToStage(operand(0));
+                        break;
+
+                    case OpTypeBool:
+                    case OpTypeSampler:
+                        result(0).opcode = opcode;
+                        break;
+
+                    case OpTypeInt:
+                        result(0).opcode = opcode;
+                        result(0).count = operand(1);
+                        result(0).isSigned = operand(2) != 0;
+                        break;
+
+                    case OpTypeFloat:
+                        result(0).opcode = opcode;
+                        result(0).count = operand(1);
+                        result(0).isSigned = true;
+                        break;
+
+                    case OpTypeVector:
+                    case OpTypeMatrix:
+                    case OpTypeArray:
+                        result(0).opcode = opcode;
+                        result(0).typeId = operand(1);
+                        result(0).count = operand(2);
+                        break;
+
+                    case OpTypeRuntimeArray:
+                    case OpTypeSampledImage:
+                        result(0).opcode = opcode;
+                        result(0).typeId = operand(1);
+                        break;
+
+                    case OpTypeImage:
+                        result(0).opcode = opcode;
+                        result(0).typeId = operand(1);
+                        result(0).count = operand(2);
+                        result(0).imageSampled = operand(6);
+                        break;
+
+                    case OpTypeStruct:
+                        result(0).opcode = opcode;
+                        result(0).members.assign(code.begin() + start + 2, code.begin() + end);
+                        break;
+
+                    case OpTypePointer:
+                        result(0).opcode = opcode;
+                        result(0).storageClass = operand(1);
+                        result(0).typeId = operand(2);
+                        break;
+
+                    case OpConstant:
+                        result(1).opcode = opcode;
+                        result(1).typeId = operand(0);
+                        result(1).constantValue = operand(2);
+                        break;
+
+                    case OpVariable:
+                        result(1).opcode = opcode;
+                        result(1).typeId = operand(0);
+                        result(1).storageClass = operand(2);
+                        break;
+
+                    case OpDecorate: {
+                        auto& target = result(0);
+
+                        switch (operand(1)) {
+                            case DecorationBlock: target.block = true; break;
+                            case DecorationBufferBlock: target.bufferBlock = true; break;
+                            case DecorationArrayStride: target.arrayStride = operand(2); break;
+                            case DecorationBuiltIn: target.builtIn = true; break;
+                            case DecorationLocation: target.location = operand(2); break;
+                            case DecorationBinding: target.binding = operand(2); break;
+                            case DecorationDescriptorSet: target.set = operand(2); break;
+                        }
+
+                        break;
+                    }
+
+                    case OpMemberDecorate: {
+                        auto& target = result(0);
+                        uint32_t const member = operand(1);
+
+                        switch (operand(2)) {
+                            case DecorationOffset: setMemberValue(target.memberOffsets, member, operand(3)); break;
+                            case DecorationMatrixStride: setMemberValue(target.memberMatrixStrides, member, operand(3)); break;
+                            case DecorationBuiltIn: target.memberBuiltIn = true; break;
+                        }
+
+                        break;
+                    }
+                }
+            }
+        };
+
+
+        VkDescriptorType getDescriptorType(SpirvId const& variable, SpirvId const& type) {
+            switch (type.opcode) {
+                case OpTypeSampler:
+                    return VK_DESCRIPTOR_TYPE_SAMPLER;
+                case OpTypeSampledImage:
+                    return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                case OpTypeImage:
+                    if (type.count == DimBuffer) {
+                        return type.imageSampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                    } else if (type.count == DimSubpassData) {
+                        return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                    }
+
+                    return type.imageSampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                case OpTypeStruct:
+                    // Older SPIR-V marks storage buffers as uniform BufferBlocks
+                    if (variable.storageClass == StorageClassStorageBuffer || type.bufferBlock) {
+                        return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                    }
+
+                    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                default:
+                    throw std::runtime_error("Failed to reflect shader: Unsupported descriptor type for '" + variable.name + "'.");
+            }
+        }
+
+
+        VkFormat getVertexFormat(SpirvId const& scalar, uint32_t const componentCount) {
+            static VkFormat const float32Formats[] = {
+                VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+            static VkFormat const float64Formats[] = {
+                VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT};
+            static VkFormat const sint32Formats[] = {
+                VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+            static VkFormat const uint32Formats[] = {
+                VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+
+            if (componentCount < 1 || componentCount > 4) {
+                throw std::runtime_error("Failed to reflect shader: Unsupported vertex input component count.");
+            }
+
+            if (scalar.opcode == OpTypeFloat && scalar.count == 32) {
+                return float32Formats[componentCount - 1];
+            } else if (scalar.opcode == OpTypeFloat && scalar.count == 64) {
+                return float64Formats[componentCount - 1];
+            } else if (scalar.opcode == OpTypeInt && scalar.count == 32) {
+                return scalar.isSigned ? sint32Formats[componentCount - 1] : uint32Formats[componentCount - 1];
+            }
+
+            throw std::runtime_error("Failed to reflect shader: Unsupported vertex input type.");
+        }
+
+    }
+
+
+    ShaderReflection::ShaderReflection(std::vector<uint32_t> const& code) {
+        SpirvModule const module(code);
+        this->stageFlags = module.stageFlags;
+
+        for (auto const& variable : module.ids) {
+            if (variable.opcode != OpVariable) {
+                continue;
+            }
+
+            auto const& pointer = module.get(variable.typeId);
+            uint32_t typeId = pointer.typeId;
+
+            switch (variable.storageClass) {
+                case StorageClassUniformConstant:
+                case StorageClassUniform:
+                case StorageClassStorageBuffer: {
+                    if (variable.binding == unset) {
+                        continue;
+                    }
+
+                    uint32_t descriptorCount = 1;
+
+                    if (module.get(typeId).opcode == OpTypeArray) {
+                        descriptorCount = module.get(module.get(typeId).count).constantValue;
+                        typeId = module.get(typeId).typeId;
+                    } else if (module.get(typeId).opcode == OpTypeRuntimeArray) {
+                        descriptorCount = 0;
+                        typeId = module.get(typeId).typeId;
+                    }
+
+                    ReflectedDescriptor descriptor {};
+                    descriptor.set = variable.set != unset ? variable.set : 0;
+                    descriptor.binding = variable.binding;
+                    descriptor.descriptorType = getDescriptorType(variable, module.get(typeId));
+                    descriptor.descriptorCount = descriptorCount;
+                    descriptor.stageFlags = this->stageFlags;
+                    descriptor.name = variable.name;
+                    this->descriptors.push_back(descriptor);
+                    break;
+                }
+
+                case StorageClassPushConstant: {
+                    auto const& block = module.get(typeId);
+                    uint32_t begin = std::numeric_limits<uint32_t>::max();
+
+                    for (auto const offset : block.memberOffsets) {
+                        begin = std::min(begin, offset);
+                    }
+
+                    if (block.members.empty() || begin == unset) {
+                        begin = 0;
+                    }
+
+                    // Ranges must be a multiple of 4 in size
+                    uint32_t const end = (module.sizeOf(typeId) + 3) & ~3u;
+
+                    VkPushConstantRange range {};
+                    range.stageFlags = this->stageFlags;
+                    range.offset = begin;
+                    range.size = end - begin;
+                    this->pushConstantRanges.push_back(range);
+                    break;
+                }
+
+                case StorageClassInput: {
+                    if (!(this->stageFlags & VK_SHADER_STAGE_VERTEX_BIT) || variable.builtIn || module.get(typeId).memberBuiltIn) {
+                        continue;
+                    }
+
+                    if (variable.location == unset) {
+                        throw std::runtime_error("Failed to reflect shader: Vertex input '" + variable.name + "' has no location.");
+                    }
+
+                    // Matrices take one location per column
+                    auto const& type = module.get(typeId);
+                    uint32_t const columnCount = type.opcode == OpTypeMatrix ? type.count : 1;
+                    auto const& column = type.opcode == OpTypeMatrix ? module.get(type.typeId) : type;
+                    uint32_t const componentCount = column.opcode == OpTypeVector ? column.count : 1;
+                    auto const& scalar = column.opcode == OpTypeVector ? module.get(column.typeId) : column;
+
+                    for (uint32_t i = 0; i < columnCount; i++) {
+                        ReflectedVertexInput input {};
+                        input.location = variable.location + i;
+                        input.format = getVertexFormat(scalar, componentCount);
+                        input.size = componentCount * (scalar.count / 8);
+                        input.name = variable.name;
+                        this->vertexInputs.push_back(input);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        std::sort(this->vertexInputs.begin(), this->vertexInputs.end(), [](auto const& a, auto const& b) {
+            return a.location < b.location;
+        });
+    }
+
+
+    ReflectedDescriptor& ShaderReflection::getDescriptor(uint32_t const set, uint32_t const binding) {
+        for (auto& descriptor : this->descriptors) {
+            if (descriptor.set == set && descriptor.binding == binding) {
+                return descriptor;
+            }
+        }
+
+        throw std::runtime_error(
+            "No descriptor at set " + std::to_string(set) + ", binding " + std::to_string(binding) + " in shader reflection.");
+    }
+
+
+    ShaderReflection& ShaderReflection::merge(ShaderReflection const& other) {
+        this->stageFlags |= other.stageFlags;
+
+        for (auto const& descriptor : other.descriptors) {
+            auto const existing = std::find_if(this->descriptors.begin(), this->descriptors.end(), [&](auto const& d) {
+                return d.set == descriptor.set && d.binding == descriptor.binding;
+            });
+
+            if (existing == this->descriptors.end()) {
+                this->descriptors.push_back(descriptor);
+                continue;
+            }
+
+            if (existing->descriptorType != descriptor.descriptorType) {
+                throw std::runtime_error("Failed to merge shader reflections: Stages disagree on type of '" + descriptor.name + "'.");
+            }
+
+            existing->stageFlags |= descriptor.stageFlags;
+            existing->descriptorCount = std::max(existing->descriptorCount, descriptor.descriptorCount);
+        }
+
+        // Identical blocks in several stages become one range visible to all of them
+        for (auto const& range : other.pushConstantRanges) {
+            auto const existing = std::find_if(this->pushConstantRanges.begin(), this->pushConstantRanges.end(), [&](auto const& r) {
+                return r.offset == range.offset && r.size == range.size;
+            });
+
+            if (existing != this->pushConstantRanges.end()) {
+                existing->stageFlags |= range.stageFlags;
+            } else {
+                this->pushConstantRanges.push_back(range);
+            }
+        }
+
+        if (this->vertexInputs.empty()) {
+            this->vertexInputs = other.vertexInputs;
+        }
+
+        return *this;
+    }
+
+
+    ShaderReflection& ShaderReflection::setDescriptorType(
+        uint32_t const set,
+        uint32_t const binding,
+        VkDescriptorType const descriptorType
+    ) {
+        this->getDescriptor(set, binding).descriptorType = descriptorType;
+        return *this;
+    }
+
+
+    ShaderReflection& ShaderReflection::setDescriptorCount(
+        uint32_t const set,
+        uint32_t const binding,
+        uint32_t const descriptorCount
+    ) {
+        this->getDescriptor(set, binding).descriptorCount = descriptorCount;
+        return *this;
+    }
+
+
+    uint32_t ShaderReflection::getDescriptorSetCount() const {
+        uint32_t count = 0;
+
+        for (auto const& descriptor : this->descriptors) {
+            count = std::max(count, descriptor.set + 1);
+        }
+
+        return count;
+    }
+
+
+    DescriptorSetLayoutConfig ShaderReflection::getDescriptorSetLayoutConfig(uint32_t const set) const {
+        std::vector<ReflectedDescriptor> setDescriptors;
+
+        for (auto const& descriptor : this->descriptors) {
+            if (descriptor.set == set) {
+                setDescriptors.push_back(descriptor);
+            }
+        }
+
+        std::sort(setDescriptors.begin(), setDescriptors.end(), [](auto const& a, auto const& b) {
+            return a.binding < b.binding;
+        });
+
+        DescriptorSetLayoutConfig config;
+
+        for (auto const& descriptor : setDescriptors) {
+            if (descriptor.descriptorCount == 0) {
+                throw std::runtime_error("Failed to build descriptor set layout: '" + descriptor.name + "' has no descriptor count.");
+            }
+
+            config.addDescriptor(descriptor.binding, descriptor.descriptorType, descriptor.stageFlags, descriptor.descriptorCount);
+        }
+
+        return config;
+    }
+
+
+    VertexInfo ShaderReflection::getVertexInfo(VkVertexInputRate const inputRate) const {
+        VertexInfo vertexInfo;
+
+        if (this->vertexInputs.empty()) {
+            return vertexInfo;
+        }
+
+        uint32_t stride = 0;
+
+        for (auto const& input : this->vertexInputs) {
+            stride += input.size;
+        }
+
+        uint32_t const index = vertexInfo.addVertexType(stride, inputRate);
+        uint32_t offset = 0;
+
+        for (auto const& input : this->vertexInputs) {
+            vertexInfo.addVertexAttribute(index, input.location, input.format, offset);
+            offset += input.size;
+        }
+
+        return vertexInfo;
+    }
+
+}
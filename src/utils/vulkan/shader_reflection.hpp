@@ -0,0 +1,139 @@
+#pragma once
+
+#include "utils/vulkan/descriptor_set_layout.hpp"
+#include "utils/vulkan/graphics_pipeline.hpp"
+
+#include "vulkan/vulkan.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief A descriptor binding used by a shader.
+     */
+    struct ReflectedDescriptor {
+        uint32_t set;
+        uint32_t binding;
+        VkDescriptorType descriptorType;
+
+        // Zero for runtime sized arrays, which need a count set before building a layout
+        uint32_t descriptorCount;
+
+        VkShaderStageFlags stageFlags;
+        std::string name;
+    };
+
+
+    /**
+     * @brief A vertex attribute consumed by a vertex shader.
+     */
+    struct ReflectedVertexInput {
+        uint32_t location;
+        VkFormat format;
+        uint32_t size;
+        std::string name;
+    };
+
+
+    /**
+     * @brief Resource interface of one or more shader stages, read from SPIR-V.
+     * Only handles what our shaders use: descriptors, push constant blocks and vertex inputs.
+     * Reflection can't tell whether a buffer should be bound with a dynamic offset, so such
+     * bindings must be adjusted with setDescriptorType before building layouts.
+     */
+    class ShaderReflection {
+    private:
+        VkShaderStageFlags stageFlags = 0;
+
+        std::vector<ReflectedDescriptor> descriptors;
+        std::vector<VkPushConstantRange> pushConstantRanges;
+        std::vector<ReflectedVertexInput> vertexInputs;
+
+    private:
+        ReflectedDescriptor& getDescriptor(uint32_t const set, uint32_t const binding);
+
+    public:
+        /**
+         * @brief Create an empty reflection, for merging stages into.
+         */
+        ShaderReflection() = default;
+
+        /**
+         * @brief Reflect a SPIR-V module.
+         * @param code SPIR-V words.
+         */
+        ShaderReflection(std::vector<uint32_t> const& code);
+
+        /**
+         * @brief Combine the interface of another stage into this one.
+         * Bindings used by both are merged, and must agree on descriptor type.
+         * @param other Reflection of another shader stage.
+         * @return Reference to this object.
+         */
+        ShaderReflection& merge(ShaderReflection const& other);
+
+        /**
+         * @brief Override the descriptor type of a binding.
+         * @param set Descriptor set index.
+         * @param binding Binding index within the set.
+         * @param descriptorType New type (e.g. VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC).
+         * @return Reference to this object.
+         */
+        ShaderReflection& setDescriptorType(uint32_t const set, uint32_t const binding, VkDescriptorType const descriptorType);
+
+        /**
+         * @brief Override the descriptor count of a binding, e.g. to bound a runtime sized array.
+         * @param set Descriptor set index.
+         * @param binding Binding index within the set.
+         * @param descriptorCount New descriptor count.
+         * @return Reference to this object.
+         */
+        ShaderReflection& setDescriptorCount(uint32_t const set, uint32_t const binding, uint32_t const descriptorCount);
+
+        /**
+         * @brief Get the stages which contributed to this reflection.
+         */
+        VkShaderStageFlags getStageFlags() const {
+            return this->stageFlags;
+        }
+
+        std::vector<ReflectedDescriptor> const& getDescriptors() const {
+            return this->descriptors;
+        }
+
+        std::vector<VkPushConstantRange> const& getPushConstantRanges() const {
+            return this->pushConstantRanges;
+        }
+
+        /**
+         * @brief Get the vertex inputs, ordered by location.
+         */
+        std::vector<ReflectedVertexInput> const& getVertexInputs() const {
+            return this->vertexInputs;
+        }
+
+        /**
+         * @brief Get the number of descriptor sets a pipeline layout needs, including unused ones below the highest set.
+         */
+        uint32_t getDescriptorSetCount() const;
+
+        /**
+         * @brief Build the layout config of a descriptor set.
+         * Bindings are sorted, so identical interfaces produce identical configs.
+         * @param set Descriptor set index, unused sets produce an empty config.
+         */
+        DescriptorSetLayoutConfig getDescriptorSetLayoutConfig(uint32_t const set) const;
+
+        /**
+         * @brief Build vertex input state for a single interleaved vertex buffer.
+         * Attributes are tightly packed in location order, matching a plain struct of the inputs.
+         * @param inputRate Either VK_VERTEX_INPUT_RATE_VERTEX or VK_VERTEX_INPUT_RATE_INSTANCE.
+         */
+        VertexInfo getVertexInfo(VkVertexInputRate const inputRate = VK_VERTEX_INPUT_RATE_VERTEX) const;
+    };
+
+}
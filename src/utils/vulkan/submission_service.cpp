@@ -0,0 +1,162 @@
+#include "utils/vulkan/submission_service.hpp"
+
+#include <algorithm>
+
+
+namespace utils::vulkan {
+
+    utils::Logger SubmissionService::log("SubmissionService");
+
+
+    SubmissionService::SubmissionService(std::shared_ptr<Queue> const& queue) : queue(queue) {
+        if (!queue->hasProgressTimeline()) {
+            throw std::runtime_error("Unable to create submission service, queue has no progress timeline.");
+        }
+
+        INFO(log) << "Starting submission thread for queue '" << queue->name << "'" << std::endl;
+        this->worker = std::thread(&SubmissionService::run, this);
+    }
+
+
+    SubmissionService::~SubmissionService() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+
+        this->pendingCondition.notify_one();
+        this->worker.join();
+    }
+
+
+    uint64_t SubmissionService::enqueue(SubmitBatch const& batch) {
+        uint64_t ticket;
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            if (this->error) {
+                std::rethrow_exception(this->error);
+            }
+
+            this->pendingBatch.append(batch);
+            ticket = ++this->lastTicket;
+        }
+
+        this->pendingCondition.notify_one();
+        return ticket;
+    }
+
+
+    void SubmissionService::run() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while (true) {
+            this->pendingCondition.wait(lock, [this] {
+                return this->stopping || this->submittedTicket != this->lastTicket;
+            });
+
+            if (this->submittedTicket == this->lastTicket) {
+                return;
+            }
+
+            // Take everything enqueued so far, producers keep filling the other batch meanwhile
+            std::swap(this->pendingBatch, this->flushBatch);
+            uint64_t const flushTicket = this->lastTicket;
+
+            lock.unlock();
+
+            uint64_t progressValue = 0;
+            std::exception_ptr submitError;
+
+            try {
+                progressValue = this->queue->submit(this->flushBatch);
+            } catch (...) {
+                submitError = std::current_exception();
+            }
+
+            this->flushBatch.clear();
+            uint64_t const queueCompletedValue = this->queue->getCompletedValue();
+
+            lock.lock();
+
+            if (submitError) {
+                ERROR(log) << "Submission to queue '" << this->queue->name << "' failed." << std::endl;
+                this->error = submitError;
+                this->submittedCondition.notify_all();
+                return;
+            }
+
+            this->flushes.push_back({flushTicket, progressValue});
+            this->submittedTicket = flushTicket;
+
+            // Forget flushes which have already finished executing
+            while (!this->flushes.empty() && this->flushes.front().progressValue <= queueCompletedValue) {
+                this->completedTicket = this->flushes.front().lastTicket;
+                this->completedValue = this->flushes.front().progressValue;
+                this->flushes.pop_front();
+            }
+
+            this->submittedCondition.notify_all();
+        }
+    }
+
+
+    uint64_t SubmissionService::getProgressValue(uint64_t const ticket) const {
+        if (ticket <= this->completedTicket) {
+            return this->completedValue;
+        }
+
+        auto const flush = std::lower_bound(
+            this->flushes.begin(), this->flushes.end(), ticket,
+            [](Flush const& entry, uint64_t const ticket) { return entry.lastTicket < ticket; });
+
+        return flush->progressValue;
+    }
+
+
+    uint64_t SubmissionService::waitSubmitted(uint64_t const ticket) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        if (ticket > this->lastTicket) {
+            throw std::runtime_error("Unable to wait for submission, ticket has not been issued.");
+        }
+
+        this->submittedCondition.wait(lock, [&] {
+            return this->error || this->submittedTicket >= ticket;
+        });
+
+        if (this->error) {
+            std::rethrow_exception(this->error);
+        }
+
+        return this->getProgressValue(ticket);
+    }
+
+
+    bool SubmissionService::isComplete(uint64_t const ticket) {
+        uint64_t progressValue;
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            if (ticket <= this->completedTicket) {
+                return true;
+            }
+
+            if (ticket > this->submittedTicket) {
+                return false;
+            }
+
+            progressValue = this->getProgressValue(ticket);
+        }
+
+        return this->queue->isComplete(progressValue);
+    }
+
+
+    void SubmissionService::waitFor(uint64_t const ticket) {
+        this->queue->waitFor(this->waitSubmitted(ticket));
+    }
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/queue.hpp"
+#include "utils/vulkan/submit_batch.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Accepts queue submissions from any thread and submits them on a dedicated thread.
+     *
+     * Batches are submitted in the order they were enqueued. Everything enqueued while the
+     * worker is busy is coalesced into a single vkQueueSubmit. Each enqueue returns a ticket,
+     * which can be used to wait for the work to be submitted or completed. Requires the
+     * queue to have a progress timeline.
+     */
+    class SubmissionService {
+    private:
+        static utils::Logger log;
+
+        struct Flush {
+            uint64_t lastTicket;
+            uint64_t progressValue;
+        };
+
+        std::shared_ptr<Queue> const queue;
+
+        std::mutex mutex;
+        std::condition_variable pendingCondition;
+        std::condition_variable submittedCondition;
+
+        // Filled by producers, swapped with flushBatch by the worker so both keep their storage
+        SubmitBatch pendingBatch;
+        SubmitBatch flushBatch;
+
+        uint64_t lastTicket = 0;
+        uint64_t submittedTicket = 0;
+
+        // Tickets up to completedTicket are known to have finished executing
+        uint64_t completedTicket = 0;
+        uint64_t completedValue = 0;
+        std::deque<Flush> flushes;
+
+        bool stopping = false;
+        std::exception_ptr error;
+
+        std::thread worker;
+
+        /**
+         * @brief Worker thread main loop.
+         */
+        void run();
+
+        /**
+         * @brief Get the progress value a submitted ticket will signal, the mutex must be held.
+         */
+        uint64_t getProgressValue(uint64_t const ticket) const;
+
+    public:
+        SubmissionService(std::shared_ptr<Queue> const& queue);
+
+        /**
+         * @brief Submit all outstanding work and stop the worker thread.
+         */
+        ~SubmissionService();
+
+        SubmissionService(SubmissionService const&) = delete;
+        SubmissionService& operator=(SubmissionService const&) = delete;
+
+        /**
+         * @brief Queue a batch for submission.
+         * The batch is copied, so the caller may clear and reuse it immediately.
+         * @param batch Batch of submissions.
+         * @return Ticket identifying the batch.
+         */
+        uint64_t enqueue(SubmitBatch const& batch);
+
+        /**
+         * @brief Block until a ticket has been submitted to the queue.
+         * Work which waits on binary semaphores signalled by the ticket, such as presentation,
+         * must not be issued before this returns.
+         * @param ticket Ticket returned by enqueue().
+         * @return Queue progress value which is reached once the ticket's work completes.
+         */
+        uint64_t waitSubmitted(uint64_t const ticket);
+
+        /**
+         * @brief Check whether a ticket's work has finished executing.
+         * @param ticket Ticket returned by enqueue().
+         */
+        bool isComplete(uint64_t const ticket);
+
+        /**
+         * @brief Block until a ticket's work has finished executing.
+         * @param ticket Ticket returned by enqueue().
+         */
+        void waitFor(uint64_t const ticket);
+    };
+
+}
@@ -0,0 +1,182 @@
+#include "utils/vulkan/submit_batch.hpp"
+#include "utils/vulkan/semaphore.hpp"
+#include "utils/vulkan/timeline_semaphore.hpp"
+#include "utils/vulkan/command_buffer.hpp"
+#include "utils/vulkan/queue.hpp"
+
+
+namespace utils::vulkan {
+
+    SubmitBatch::SubmitRange& SubmitBatch::currentSubmit() {
+        if (this->submitRanges.empty()) {
+            this->beginSubmit();
+        }
+
+        return this->submitRanges.back();
+    }
+
+
+    SubmitBatch& SubmitBatch::beginSubmit() {
+        SubmitRange range {};
+        range.firstWait = static_cast<uint32_t>(this->waitSemaphores.size());
+        range.firstCommandBuffer = static_cast<uint32_t>(this->commandBuffers.size());
+        range.firstSignal = static_cast<uint32_t>(this->signalSemaphores.size());
+
+        this->submitRanges.push_back(range);
+        return *this;
+    }
+
+
+    SubmitBatch& SubmitBatch::addWait(VkSemaphore const semaphore, VkPipelineStageFlags const waitStage) {
+        this->currentSubmit().waitCount++;
+        this->waitSemaphores.push_back(semaphore);
+        this->waitStages.push_back(waitStage);
+        this->waitValues.push_back(0);
+        return *this;
+    }
+
+
+    SubmitBatch& SubmitBatch::addWait(std::shared_ptr<Semaphore> const& semaphore, VkPipelineStageFlags const waitStage) {
+        return this->addWait(semaphore->getHandle()->vk, waitStage);
+    }
+
+
+    SubmitBatch& SubmitBatch::addTimelineWait(VkSemaphore const semaphore, VkPipelineStageFlags const waitStage, uint64_t const value) {
+        this->addWait(semaphore, waitStage);
+        this->waitValues.back() = value;
+        this->hasTimelineValues = true;
+        return *this;
+    }
+
+
+    SubmitBatch& SubmitBatch::addWait(std::shared_ptr<TimelineSemaphore> const& semaphore, VkPipelineStageFlags const waitStage, uint64_t const value) {
+        return this->addTimelineWait(semaphore->getHandle()->vk, waitStage, value);
+    }
+
+
+    SubmitBatch& SubmitBatch::addWait(std::shared_ptr<Queue> const& queue, VkPipelineStageFlags const waitStage, uint64_t const value) {
+        if (!queue->hasProgressTimeline()) {
+            throw std::runtime_error("Unable to wait for queue, it has no progress timeline.");
+        }
+
+        return this->addWait(queue->getProgressSemaphore(), waitStage, value);
+    }
+
+
+    SubmitBatch& SubmitBatch::addCommandBuffer(VkCommandBuffer const commandBuffer) {
+        this->currentSubmit().commandBufferCount++;
+        this->commandBuffers.push_back(commandBuffer);
+        return *this;
+    }
+
+
+    SubmitBatch& SubmitBatch::addCommandBuffer(std::shared_ptr<CommandBuffer> const& commandBuffer) {
+        return this->addCommandBuffer(commandBuffer->vk);
+    }
+
+
+    SubmitBatch& SubmitBatch::addSignal(VkSemaphore const semaphore) {
+        this->currentSubmit().signalCount++;
+        this->signalSemaphores.push_back(semaphore);
+        this->signalValues.push_back(0);
+        return *this;
+    }
+
+
+    SubmitBatch& SubmitBatch::addSignal(std::shared_ptr<Semaphore> const& semaphore) {
+        return this->addSignal(semaphore->getHandle()->vk);
+    }
+
+
+    SubmitBatch& SubmitBatch::addTimelineSignal(VkSemaphore const semaphore, uint64_t const value) {
+        this->addSignal(semaphore);
+        this->signalValues.back() = value;
+        this->hasTimelineValues = true;
+        return *this;
+    }
+
+
+    SubmitBatch& SubmitBatch::addSignal(std::shared_ptr<TimelineSemaphore> const& semaphore, uint64_t const value) {
+        return this->addTimelineSignal(semaphore->getHandle()->vk, value);
+    }
+
+
+    SubmitBatch& SubmitBatch::append(SubmitBatch const& other) {
+        uint32_t const waitOffset = static_cast<uint32_t>(this->waitSemaphores.size());
+        uint32_t const commandBufferOffset = static_cast<uint32_t>(this->commandBuffers.size());
+        uint32_t const signalOffset = static_cast<uint32_t>(this->signalSemaphores.size());
+
+        this->waitSemaphores.insert(this->waitSemaphores.end(), other.waitSemaphores.begin(), other.waitSemaphores.end());
+        this->waitStages.insert(this->waitStages.end(), other.waitStages.begin(), other.waitStages.end());
+        this->waitValues.insert(this->waitValues.end(), other.waitValues.begin(), other.waitValues.end());
+        this->commandBuffers.insert(this->commandBuffers.end(), other.commandBuffers.begin(), other.commandBuffers.end());
+        this->signalSemaphores.insert(this->signalSemaphores.end(), other.signalSemaphores.begin(), other.signalSemaphores.end());
+        this->signalValues.insert(this->signalValues.end(), other.signalValues.begin(), other.signalValues.end());
+        this->hasTimelineValues = this->hasTimelineValues || other.hasTimelineValues;
+
+        for (auto range : other.submitRanges) {
+            range.firstWait += waitOffset;
+            range.firstCommandBuffer += commandBufferOffset;
+            range.firstSignal += signalOffset;
+            this->submitRanges.push_back(range);
+        }
+
+        return *this;
+    }
+
+
+    VkSubmitInfo const * SubmitBatch::getSubmitInfos() {
+        // Handle arrays may have been reallocated while the batch was filled, so pointers
+        // are only resolved here, once the batch is complete.
+        this->submitInfos.resize(this->submitRanges.size());
+
+        if (this->hasTimelineValues) {
+            this->timelineInfos.resize(this->submitRanges.size());
+        }
+
+        for (unsigned i = 0; i < this->submitRanges.size(); i++) {
+            auto const& range = this->submitRanges[i];
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.waitSemaphoreCount = range.waitCount;
+            submitInfo.pWaitSemaphores = this->waitSemaphores.data() + range.firstWait;
+            submitInfo.pWaitDstStageMask = this->waitStages.data() + range.firstWait;
+            submitInfo.commandBufferCount = range.commandBufferCount;
+            submitInfo.pCommandBuffers = this->commandBuffers.data() + range.firstCommandBuffer;
+            submitInfo.signalSemaphoreCount = range.signalCount;
+            submitInfo.pSignalSemaphores = this->signalSemaphores.data() + range.firstSignal;
+
+            if (this->hasTimelineValues) {
+                VkTimelineSemaphoreSubmitInfoKHR timelineInfo {};
+                timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+                timelineInfo.waitSemaphoreValueCount = range.waitCount;
+                timelineInfo.pWaitSemaphoreValues = this->waitValues.data() + range.firstWait;
+                timelineInfo.signalSemaphoreValueCount = range.signalCount;
+                timelineInfo.pSignalSemaphoreValues = this->signalValues.data() + range.firstSignal;
+
+                this->timelineInfos[i] = timelineInfo;
+                submitInfo.pNext = &this->timelineInfos[i];
+            }
+
+            this->submitInfos[i] = submitInfo;
+        }
+
+        return this->submitInfos.data();
+    }
+
+
+    void SubmitBatch::clear() {
+        this->waitSemaphores.clear();
+        this->waitStages.clear();
+        this->waitValues.clear();
+        this->commandBuffers.clear();
+        this->signalSemaphores.clear();
+        this->signalValues.clear();
+        this->hasTimelineValues = false;
+        this->submitRanges.clear();
+        this->submitInfos.clear();
+        this->timelineInfos.clear();
+    }
+
+}
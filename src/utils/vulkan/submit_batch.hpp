@@ -0,0 +1,174 @@
+#pragma once
+
+#include "vulkan/vulkan.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace utils::vulkan {
+
+    class Semaphore;
+    class TimelineSemaphore;
+    class Queue;
+    class CommandBuffer;
+
+
+    /**
+     * @brief Reusable set of queue submissions, flushed with a single vkQueueSubmit.
+     *
+     * Handles are stored in flat arrays shared by every submission in the batch, and the
+     * VkSubmitInfo pointers are fixed up when the batch is flushed. Storage is retained
+     * across calls to clear(), so a long lived batch does not allocate in steady state.
+     * Timeline semaphore values are only chained into the submit infos if at least one
+     * timeline wait or signal was added to the batch.
+     */
+    class SubmitBatch {
+    private:
+        struct SubmitRange {
+            uint32_t firstWait;
+            uint32_t waitCount;
+            uint32_t firstCommandBuffer;
+            uint32_t commandBufferCount;
+            uint32_t firstSignal;
+            uint32_t signalCount;
+        };
+
+        std::vector<VkSemaphore> waitSemaphores;
+        std::vector<VkPipelineStageFlags> waitStages;
+        std::vector<uint64_t> waitValues;
+        std::vector<VkCommandBuffer> commandBuffers;
+        std::vector<VkSemaphore> signalSemaphores;
+        std::vector<uint64_t> signalValues;
+
+        // Set once any timeline semaphore is added, binary semaphores then get a value of 0
+        bool hasTimelineValues = false;
+
+        std::vector<SubmitRange> submitRanges;
+        std::vector<VkSubmitInfo> submitInfos;
+        std::vector<VkTimelineSemaphoreSubmitInfoKHR> timelineInfos;
+
+        /**
+         * @brief Get the submission currently being added to, starting one if there is none.
+         */
+        SubmitRange& currentSubmit();
+
+    public:
+        /**
+         * @brief Start a new submission within the batch.
+         * Waits, command buffers and signals added afterwards belong to the new submission.
+         */
+        SubmitBatch& beginSubmit();
+
+        /**
+         * @brief Add a semaphore for the current submission to wait on.
+         * @param semaphore Raw handle of the semaphore.
+         * @param waitStage Stages which must wait for the semaphore.
+         */
+        SubmitBatch& addWait(VkSemaphore const semaphore, VkPipelineStageFlags const waitStage);
+
+        /**
+         * @brief Add a semaphore for the current submission to wait on.
+         * @param semaphore Shared pointer to the semaphore.
+         * @param waitStage Stages which must wait for the semaphore.
+         */
+        SubmitBatch& addWait(std::shared_ptr<Semaphore> const& semaphore, VkPipelineStageFlags const waitStage);
+
+        /**
+         * @brief Add a timeline semaphore value for the current submission to wait on.
+         * @param semaphore Raw handle of the timeline semaphore.
+         * @param waitStage Stages which must wait for the semaphore.
+         * @param value Value the semaphore must reach before the stages may execute.
+         */
+        SubmitBatch& addTimelineWait(VkSemaphore const semaphore, VkPipelineStageFlags const waitStage, uint64_t const value);
+
+        /**
+         * @brief Add a timeline semaphore value for the current submission to wait on.
+         * @param semaphore Shared pointer to the timeline semaphore.
+         * @param waitStage Stages which must wait for the semaphore.
+         * @param value Value the semaphore must reach before the stages may execute.
+         */
+        SubmitBatch& addWait(std::shared_ptr<TimelineSemaphore> const& semaphore, VkPipelineStageFlags const waitStage, uint64_t const value);
+
+        /**
+         * @brief Wait for a submission made to another queue, e.g. async compute results
+         * consumed by the graphics queue. Resources written by the other queue must either be
+         * VK_SHARING_MODE_CONCURRENT or have their ownership transferred with barriers.
+         * @param queue Shared pointer to the queue the work was submitted to.
+         * @param waitStage Stages which must wait for the work to complete.
+         * @param value Progress value returned when the work was submitted.
+         */
+        SubmitBatch& addWait(std::shared_ptr<Queue> const& queue, VkPipelineStageFlags const waitStage, uint64_t const value);
+
+        /**
+         * @brief Add a command buffer to the current submission.
+         * @param commandBuffer Raw handle of the command buffer.
+         */
+        SubmitBatch& addCommandBuffer(VkCommandBuffer const commandBuffer);
+
+        /**
+         * @brief Add a command buffer to the current submission.
+         * @param commandBuffer Shared pointer to the command buffer.
+         */
+        SubmitBatch& addCommandBuffer(std::shared_ptr<CommandBuffer> const& commandBuffer);
+
+        /**
+         * @brief Add a semaphore for the current submission to signal on completion.
+         * @param semaphore Raw handle of the semaphore.
+         */
+        SubmitBatch& addSignal(VkSemaphore const semaphore);
+
+        /**
+         * @brief Add a semaphore for the current submission to signal on completion.
+         * @param semaphore Shared pointer to the semaphore.
+         */
+        SubmitBatch& addSignal(std::shared_ptr<Semaphore> const& semaphore);
+
+        /**
+         * @brief Add a timeline semaphore value for the current submission to signal on completion.
+         * @param semaphore Raw handle of the timeline semaphore.
+         * @param value Value to set the semaphore to.
+         */
+        SubmitBatch& addTimelineSignal(VkSemaphore const semaphore, uint64_t const value);
+
+        /**
+         * @brief Add a timeline semaphore value for the current submission to signal on completion.
+         * @param semaphore Shared pointer to the timeline semaphore.
+         * @param value Value to set the semaphore to.
+         */
+        SubmitBatch& addSignal(std::shared_ptr<TimelineSemaphore> const& semaphore, uint64_t const value);
+
+        /**
+         * @brief Append every submission in another batch, preserving their order.
+         * @param other Batch to copy submissions from.
+         */
+        SubmitBatch& append(SubmitBatch const& other);
+
+        /**
+         * @brief Check whether the batch contains any submissions.
+         */
+        bool isEmpty() const {
+            return this->submitRanges.empty();
+        }
+
+        /**
+         * @brief Get the number of submissions in the batch.
+         */
+        uint32_t getSubmitCount() const {
+            return static_cast<uint32_t>(this->submitRanges.size());
+        }
+
+        /**
+         * @brief Build submit info structures for the batch.
+         * Pointers in the returned structures remain valid until the batch is next modified.
+         * @return Pointer to getSubmitCount() VkSubmitInfo structures.
+         */
+        VkSubmitInfo const * getSubmitInfos();
+
+        /**
+         * @brief Remove all submissions, retaining storage for reuse.
+         */
+        void clear();
+    };
+
+}
@@ -0,0 +1,75 @@
+#include "utils/vulkan/timeline_semaphore.hpp"
+
+
+namespace utils::vulkan {
+
+    utils::Logger TimelineSemaphore::log("TimelineSemaphore");
+
+
+    TimelineSemaphore::TimelineSemaphore(std::shared_ptr<DeviceHandle> const& vkDeviceHandle, uint64_t const initialValue) :
+        HandleWrapper<SemaphoreHandle>(std::make_shared<SemaphoreHandle>(vkDeviceHandle)),
+        vkDeviceHandle(vkDeviceHandle)
+    {
+        if (this->vkDeviceHandle->functions.vkGetSemaphoreCounterValue == nullptr) {
+            throw std::runtime_error("Unable to create timeline semaphore, VK_KHR_timeline_semaphore is not enabled.");
+        }
+
+        VkSemaphoreTypeCreateInfoKHR typeInfo {};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        typeInfo.initialValue = initialValue;
+
+        VkSemaphoreCreateInfo createInfo {};
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = &typeInfo;
+
+        if (vkCreateSemaphore(this->vkDeviceHandle->vk, &createInfo, nullptr, &this->vkHandle->vk) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timeline semaphore.");
+        }
+    }
+
+
+    uint64_t TimelineSemaphore::getValue() const {
+        uint64_t value = 0;
+
+        if (this->vkDeviceHandle->functions.vkGetSemaphoreCounterValue(this->vkDeviceHandle->vk, this->vkHandle->vk, &value) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to get timeline semaphore value.");
+        }
+
+        return value;
+    }
+
+
+    bool TimelineSemaphore::wait(uint64_t const value, uint64_t const timeout) const {
+        VkSemaphoreWaitInfoKHR waitInfo {};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &this->vkHandle->vk;
+        waitInfo.pValues = &value;
+
+        VkResult const rc = this->vkDeviceHandle->functions.vkWaitSemaphores(this->vkDeviceHandle->vk, &waitInfo, timeout);
+
+        if (rc == VK_TIMEOUT) {
+            return false;
+        }
+
+        if (rc != VK_SUCCESS) {
+            throw std::runtime_error("Failed to wait for timeline semaphore.");
+        }
+
+        return true;
+    }
+
+
+    void TimelineSemaphore::signal(uint64_t const value) {
+        VkSemaphoreSignalInfoKHR signalInfo {};
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+        signalInfo.semaphore = this->vkHandle->vk;
+        signalInfo.value = value;
+
+        if (this->vkDeviceHandle->functions.vkSignalSemaphore(this->vkDeviceHandle->vk, &signalInfo) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to signal timeline semaphore.");
+        }
+    }
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "utils/misc/logging.hpp"
+#include "utils/vulkan/handles.hpp"
+
+
+namespace utils::vulkan {
+
+    /**
+     * @brief Semaphore with a monotonically increasing 64 bit counter.
+     * Requires the VK_KHR_timeline_semaphore device extension. Unlike binary semaphores,
+     * any number of submissions and host threads may wait on a value, and the host can
+     * query progress without a fence.
+     */
+    class TimelineSemaphore : public HandleWrapper<SemaphoreHandle> {
+    private:
+        static utils::Logger log;
+
+        std::shared_ptr<DeviceHandle> const vkDeviceHandle;
+
+    public:
+        TimelineSemaphore(std::shared_ptr<DeviceHandle> const& vkDeviceHandle, uint64_t const initialValue = 0);
+
+        /**
+         * @brief Get the current value of the counter.
+         */
+        uint64_t getValue() const;
+
+        /**
+         * @brief Wait on the host for the counter to reach a value.
+         * @param value Value to wait for.
+         * @param timeout Timeout in nanoseconds.
+         * @return True if the value was reached, false if the wait timed out.
+         */
+        bool wait(uint64_t const value, uint64_t const timeout = UINT64_MAX) const;
+
+        /**
+         * @brief Set the counter from the host.
+         * @param value New counter value, must be greater than the current value.
+         */
+        void signal(uint64_t const value);
+    };
+
+}
@@ -0,0 +1,203 @@
+#include "utils/vulkan/shader_reflection.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace utils::vulkan;
+
+
+/**
+ * @brief Minimal SPIR-V assembler, just enough to describe shader interfaces.
+ */
+struct SpirvBuilder {
+    std::vector<uint32_t> code = {0x07230203, 0x00010000, 0, 64, 0};
+
+    void op(uint32_t const opcode, std::vector<uint32_t> const& operands) {
+        code.push_back(static_cast<uint32_t>(operands.size() + 1) << 16 | opcode);
+        code.insert(code.end(), operands.begin(), operands.end());
+    }
+
+    static std::vector<uint32_t> string(std::string const& value) {
+        std::vector<uint32_t> words(value.size() / 4 + 1, 0);
+
+        for (unsigned i = 0; i < value.size(); i++) {
+            words[i / 4] |= static_cast<uint32_t>(value[i]) << (i % 4 * 8);
+        }
+
+        return words;
+    }
+
+    void name(uint32_t const id, std::string const& value) {
+        auto operands = string(value);
+        operands.insert(operands.begin(), id);
+        op(5, operands);
+    }
+};
+
+
+/**
+ * @brief Common types: 1 float, 2 vec2, 3 vec3, 4 vec4, 5 mat4, 6 uint.
+ * Push constant block: 9 struct { mat4 }, 10 pointer, 11 variable.
+ */
+static void addCommonTypes(SpirvBuilder& builder) {
+    builder.op(22, {1, 32});
+    builder.op(23, {2, 1, 2});
+    builder.op(23, {3, 1, 3});
+    builder.op(23, {4, 1, 4});
+    builder.op(24, {5, 4, 4});
+    builder.op(21, {6, 32, 0});
+
+    builder.op(30, {9, 5});
+    builder.op(71, {9, 2});
+    builder.op(72, {9, 0, 35, 0});
+    builder.op(72, {9, 0, 7, 16});
+    builder.op(32, {10, 9, 9});
+    builder.op(59, {10, 11, 9});
+}
+
+
+/**
+ * @brief Equivalent of data/shaders/triangle/vertex.vert.
+ */
+static std::vector<uint32_t> buildVertexShader() {
+    SpirvBuilder builder;
+
+    auto entryPoint = SpirvBuilder::string("main");
+    entryPoint.insert(entryPoint.begin(), {0, 40});
+    entryPoint.insert(entryPoint.end(), {13, 15, 18});
+    builder.op(15, entryPoint);
+
+    addCommonTypes(builder);
+
+    // Uniform block { mat4 view; mat4 projection; } at binding 0
+    builder.op(30, {7, 5, 5});
+    builder.op(71, {7, 2});
+    builder.op(72, {7, 0, 35, 0});
+    builder.op(72, {7, 0, 7, 16});
+    builder.op(72, {7, 1, 35, 64});
+    builder.op(72, {7, 1, 7, 16});
+    builder.op(32, {8, 2, 7});
+    builder.op(59, {8, 12, 2});
+    builder.op(71, {12, 33, 0});
+    builder.op(71, {12, 34, 0});
+    builder.name(12, "uniforms");
+
+    // Inputs: vec2 at location 0, vec3 at location 1, gl_VertexIndex
+    builder.op(32, {14, 1, 2});
+    builder.op(59, {14, 13, 1});
+    builder.op(71, {13, 30, 0});
+    builder.op(32, {16, 1, 3});
+    builder.op(59, {16, 15, 1});
+    builder.op(71, {15, 30, 1});
+    builder.op(32, {17, 1, 6});
+    builder.op(59, {17, 18, 1});
+    builder.op(71, {18, 11, 42});
+
+    return builder.code;
+}
+
+
+/**
+ * @brief Fragment shader using the same push constants and an array of four combined image samplers.
+ */
+static std::vector<uint32_t> buildFragmentShader() {
+    SpirvBuilder builder;
+
+    auto entryPoint = SpirvBuilder::string("main");
+    entryPoint.insert(entryPoint.begin(), {4, 40});
+    builder.op(15, entryPoint);
+
+    addCommonTypes(builder);
+
+    builder.op(25, {20, 1, 1, 0, 0, 0, 1, 0});
+    builder.op(27, {21, 20});
+    builder.op(43, {6, 23, 4});
+    builder.op(28, {24, 21, 23});
+    builder.op(32, {25, 0, 24});
+    builder.op(59, {25, 26, 0});
+    builder.op(71, {26, 34, 1});
+    builder.op(71, {26, 33, 2});
+    builder.name(26, "textures");
+
+    return builder.code;
+}
+
+
+TEST_CASE("ShaderReflection reads descriptors, push constants and vertex inputs", "[shader_reflection]") {
+    ShaderReflection const reflection(buildVertexShader());
+
+    REQUIRE(reflection.getStageFlags() == VK_SHADER_STAGE_VERTEX_BIT);
+
+    auto const& descriptors = reflection.getDescriptors();
+    REQUIRE(descriptors.size() == 1);
+    REQUIRE(descriptors[0].set == 0);
+    REQUIRE(descriptors[0].binding == 0);
+    REQUIRE(descriptors[0].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    REQUIRE(descriptors[0].descriptorCount == 1);
+    REQUIRE(descriptors[0].name == "uniforms");
+
+    auto const& ranges = reflection.getPushConstantRanges();
+    REQUIRE(ranges.size() == 1);
+    REQUIRE(ranges[0].offset == 0);
+    REQUIRE(ranges[0].size == 64);
+
+    auto const& inputs = reflection.getVertexInputs();
+    REQUIRE(inputs.size() == 2);
+    REQUIRE(inputs[0].location == 0);
+    REQUIRE(inputs[0].format == VK_FORMAT_R32G32_SFLOAT);
+    REQUIRE(inputs[1].location == 1);
+    REQUIRE(inputs[1].format == VK_FORMAT_R32G32B32_SFLOAT);
+
+    auto const vertexInfo = reflection.getVertexInfo();
+    REQUIRE(vertexInfo.vertexTypes.size() == 1);
+    REQUIRE(vertexInfo.vertexTypes[0].stride == 20);
+    REQUIRE(vertexInfo.attributes.size() == 2);
+    REQUIRE(vertexInfo.attributes[0].offset == 0);
+    REQUIRE(vertexInfo.attributes[1].offset == 8);
+}
+
+
+TEST_CASE("ShaderReflection merges stages into layout configs", "[shader_reflection]") {
+    ShaderReflection reflection(buildVertexShader());
+    reflection.merge(ShaderReflection(buildFragmentShader()));
+
+    REQUIRE(reflection.getStageFlags() == (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT));
+    REQUIRE(reflection.getDescriptorSetCount() == 2);
+
+    // The identical push constant block becomes a single range visible to both stages
+    REQUIRE(reflection.getPushConstantRanges().size() == 1);
+    REQUIRE(reflection.getPushConstantRanges()[0].stageFlags == (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT));
+
+    reflection.setDescriptorType(0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+
+    auto const set0 = reflection.getDescriptorSetLayoutConfig(0);
+    REQUIRE(set0.descriptorBindings.size() == 1);
+    REQUIRE(set0.descriptorBindings[0].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+    REQUIRE(set0.descriptorBindings[0].stageFlags == VK_SHADER_STAGE_VERTEX_BIT);
+
+    auto const set1 = reflection.getDescriptorSetLayoutConfig(1);
+    REQUIRE(set1.descriptorBindings.size() == 1);
+    REQUIRE(set1.descriptorBindings[0].binding == 2);
+    REQUIRE(set1.descriptorBindings[0].descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    REQUIRE(set1.descriptorBindings[0].descriptorCount == 4);
+    REQUIRE(set1.descriptorBindings[0].stageFlags == VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    REQUIRE(reflection.getDescriptorSetLayoutConfig(2).descriptorBindings.empty());
+}
+
+
+TEST_CASE("ShaderReflection rejects invalid input", "[shader_reflection]") {
+    REQUIRE_THROWS_AS(ShaderReflection(std::vector<uint32_t>{1, 2, 3, 4, 5}), std::runtime_error);
+
+    ShaderReflection reflection(buildVertexShader());
+    REQUIRE_THROWS_AS(reflection.setDescriptorType(3, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER), std::runtime_error);
+
+    // Stages must agree on the type of shared bindings
+    ShaderReflection other(buildVertexShader());
+    other.setDescriptorType(0, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    REQUIRE_THROWS_AS(reflection.merge(other), std::runtime_error);
+}
@@ -0,0 +1,172 @@
+#include "utils/vulkan/submit_batch.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+// Count every heap allocation made by the test binary
+static std::atomic<uint64_t> allocationCount(0);
+
+
+void * operator new(std::size_t size) {
+    allocationCount++;
+
+    if (void * const pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete(void * pointer) noexcept {
+    std::free(pointer);
+}
+
+
+void operator delete(void * pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+
+template<typename T>
+static T fakeHandle(uint64_t const value) {
+    return (T)(uintptr_t) value;
+}
+
+
+static void fillFrameBatch(utils::vulkan::SubmitBatch& batch) {
+    batch.beginSubmit()
+        .addWait(fakeHandle<VkSemaphore>(1), VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT)
+        .addCommandBuffer(fakeHandle<VkCommandBuffer>(2))
+        .addCommandBuffer(fakeHandle<VkCommandBuffer>(3))
+        .addSignal(fakeHandle<VkSemaphore>(4));
+
+    batch.beginSubmit()
+        .addWait(fakeHandle<VkSemaphore>(4), VK_PIPELINE_STAGE_TRANSFER_BIT)
+        .addWait(fakeHandle<VkSemaphore>(5), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT)
+        .addCommandBuffer(fakeHandle<VkCommandBuffer>(6))
+        .addSignal(fakeHandle<VkSemaphore>(7));
+}
+
+
+TEST_CASE("SubmitBatch builds one submit info per submission", "[submit_batch]") {
+    utils::vulkan::SubmitBatch batch;
+    fillFrameBatch(batch);
+
+    REQUIRE(batch.getSubmitCount() == 2);
+
+    VkSubmitInfo const * const submitInfos = batch.getSubmitInfos();
+
+    REQUIRE(submitInfos[0].sType == VK_STRUCTURE_TYPE_SUBMIT_INFO);
+    REQUIRE(submitInfos[0].waitSemaphoreCount == 1);
+    REQUIRE(submitInfos[0].pWaitSemaphores[0] == fakeHandle<VkSemaphore>(1));
+    REQUIRE(submitInfos[0].pWaitDstStageMask[0] == VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    REQUIRE(submitInfos[0].commandBufferCount == 2);
+    REQUIRE(submitInfos[0].pCommandBuffers[1] == fakeHandle<VkCommandBuffer>(3));
+    REQUIRE(submitInfos[0].signalSemaphoreCount == 1);
+    REQUIRE(submitInfos[0].pSignalSemaphores[0] == fakeHandle<VkSemaphore>(4));
+
+    REQUIRE(submitInfos[1].waitSemaphoreCount == 2);
+    REQUIRE(submitInfos[1].pWaitSemaphores[1] == fakeHandle<VkSemaphore>(5));
+    REQUIRE(submitInfos[1].pWaitDstStageMask[1] == VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    REQUIRE(submitInfos[1].commandBufferCount == 1);
+    REQUIRE(submitInfos[1].pCommandBuffers[0] == fakeHandle<VkCommandBuffer>(6));
+    REQUIRE(submitInfos[1].pSignalSemaphores[0] == fakeHandle<VkSemaphore>(7));
+}
+
+
+TEST_CASE("SubmitBatch starts a submission implicitly", "[submit_batch]") {
+    utils::vulkan::SubmitBatch batch;
+    REQUIRE(batch.isEmpty());
+
+    batch.addCommandBuffer(fakeHandle<VkCommandBuffer>(1));
+
+    REQUIRE(batch.getSubmitCount() == 1);
+    REQUIRE(batch.getSubmitInfos()[0].commandBufferCount == 1);
+
+    batch.clear();
+    REQUIRE(batch.isEmpty());
+}
+
+
+TEST_CASE("SubmitBatch does not allocate in steady state", "[submit_batch]") {
+    utils::vulkan::SubmitBatch batch;
+
+    // First frame grows the internal storage
+    fillFrameBatch(batch);
+    batch.getSubmitInfos();
+    batch.clear();
+
+    uint64_t const allocationsBefore = allocationCount;
+
+    for (unsigned frame = 0; frame < 100; frame++) {
+        fillFrameBatch(batch);
+        batch.getSubmitInfos();
+        batch.clear();
+    }
+
+    uint64_t const allocationsAfter = allocationCount;
+
+    REQUIRE(allocationsAfter == allocationsBefore);
+}
+
+
+TEST_CASE("SubmitBatch chains timeline values only when needed", "[submit_batch]") {
+    utils::vulkan::SubmitBatch batch;
+    fillFrameBatch(batch);
+
+    REQUIRE(batch.getSubmitInfos()[0].pNext == nullptr);
+    REQUIRE(batch.getSubmitInfos()[1].pNext == nullptr);
+
+    batch.beginSubmit()
+        .addTimelineWait(fakeHandle<VkSemaphore>(8), VK_PIPELINE_STAGE_TRANSFER_BIT, 41)
+        .addCommandBuffer(fakeHandle<VkCommandBuffer>(9))
+        .addSignal(fakeHandle<VkSemaphore>(10))
+        .addTimelineSignal(fakeHandle<VkSemaphore>(8), 42);
+
+    VkSubmitInfo const * const submitInfos = batch.getSubmitInfos();
+
+    auto const * const binaryInfo = static_cast<VkTimelineSemaphoreSubmitInfoKHR const *>(submitInfos[0].pNext);
+    REQUIRE(binaryInfo != nullptr);
+    REQUIRE(binaryInfo->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR);
+    REQUIRE(binaryInfo->waitSemaphoreValueCount == 1);
+    REQUIRE(binaryInfo->signalSemaphoreValueCount == 1);
+
+    auto const * const timelineInfo = static_cast<VkTimelineSemaphoreSubmitInfoKHR const *>(submitInfos[2].pNext);
+    REQUIRE(timelineInfo->waitSemaphoreValueCount == 1);
+    REQUIRE(timelineInfo->pWaitSemaphoreValues[0] == 41);
+    REQUIRE(timelineInfo->signalSemaphoreValueCount == 2);
+    REQUIRE(timelineInfo->pSignalSemaphoreValues[0] == 0);
+    REQUIRE(timelineInfo->pSignalSemaphoreValues[1] == 42);
+
+    batch.clear();
+    fillFrameBatch(batch);
+    REQUIRE(batch.getSubmitInfos()[0].pNext == nullptr);
+}
+
+
+TEST_CASE("SubmitBatch appends submissions in order", "[submit_batch]") {
+    utils::vulkan::SubmitBatch first;
+    first.addCommandBuffer(fakeHandle<VkCommandBuffer>(1));
+
+    utils::vulkan::SubmitBatch second;
+    fillFrameBatch(second);
+
+    first.append(second);
+
+    REQUIRE(first.getSubmitCount() == 3);
+
+    VkSubmitInfo const * const submitInfos = first.getSubmitInfos();
+
+    REQUIRE(submitInfos[0].commandBufferCount == 1);
+    REQUIRE(submitInfos[0].pCommandBuffers[0] == fakeHandle<VkCommandBuffer>(1));
+    REQUIRE(submitInfos[1].pWaitSemaphores[0] == fakeHandle<VkSemaphore>(1));
+    REQUIRE(submitInfos[1].pCommandBuffers[1] == fakeHandle<VkCommandBuffer>(3));
+    REQUIRE(submitInfos[2].pWaitSemaphores[1] == fakeHandle<VkSemaphore>(5));
+    REQUIRE(submitInfos[2].pSignalSemaphores[0] == fakeHandle<VkSemaphore>(7));
+}
@@ -0,0 +1,47 @@
+#include "utils/misc/thread_pool.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+
+TEST_CASE("ThreadPool runs tasks and returns their results", "[thread_pool]") {
+    utils::ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    std::vector<std::future<int>> futures;
+
+    for (int i = 0; i < 64; i++) {
+        futures.push_back(pool.submit([i] { return i * i; }));
+    }
+
+    for (int i = 0; i < 64; i++) {
+        REQUIRE(futures[i].get() == i * i);
+    }
+}
+
+
+TEST_CASE("ThreadPool forwards exceptions through futures", "[thread_pool]") {
+    utils::ThreadPool pool(2);
+
+    auto future = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+
+    REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+}
+
+
+TEST_CASE("ThreadPool finishes queued tasks before stopping", "[thread_pool]") {
+    std::atomic<unsigned> completed(0);
+
+    {
+        utils::ThreadPool pool(2);
+
+        for (unsigned i = 0; i < 100; i++) {
+            pool.submit([&completed] { completed++; });
+        }
+    }
+
+    REQUIRE(completed == 100);
+}